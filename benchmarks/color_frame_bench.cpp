@@ -0,0 +1,61 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <color.hpp>
+#include <color_frame.hpp>
+#include <color_samples.hpp>
+
+namespace proud_color_sorter::benchmarks {
+
+namespace {
+
+template <bool IsPacked>
+void BM_EncodeFrame(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  std::vector<char> frame(FrameSize(colors.size(), IsPacked));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(EncodeFrame(colors.data(), colors.data() + colors.size(), IsPacked, frame.data()));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template <bool IsPacked>
+void BM_DecodeFrame(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  std::vector<char> frame(FrameSize(colors.size(), IsPacked));
+  EncodeFrame(colors.data(), colors.data() + colors.size(), IsPacked, frame.data());
+  std::vector<Color> decoded(colors.size());
+
+  for (auto _ : state) {
+    const FrameHeader header = DecodeFrameHeader(frame.data());
+    DecodeFramePayload(header, frame.data() + kFrameHeaderSize, decoded.data());
+    benchmark::DoNotOptimize(decoded.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Crc32c(benchmark::State& state) {
+  const std::vector<char> data(static_cast<std::size_t>(state.range(0)), 'x');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Crc32c(data.data(), data.size()));
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_EncodeFrame, false)->RangeMultiplier(16)->Range(1 << 8, 1 << 24);
+BENCHMARK_TEMPLATE(BM_EncodeFrame, true)->RangeMultiplier(16)->Range(1 << 8, 1 << 24);
+BENCHMARK_TEMPLATE(BM_DecodeFrame, false)->RangeMultiplier(16)->Range(1 << 8, 1 << 24);
+BENCHMARK_TEMPLATE(BM_DecodeFrame, true)->RangeMultiplier(16)->Range(1 << 8, 1 << 24);
+BENCHMARK(BM_Crc32c)->RangeMultiplier(16)->Range(1 << 8, 1 << 24);
+
+}  // namespace proud_color_sorter::benchmarks
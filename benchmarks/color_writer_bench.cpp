@@ -0,0 +1,62 @@
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <color.hpp>
+#include <color_histogram.hpp>
+#include <color_samples.hpp>
+#include <counting_sort.hpp>
+#include <sorted_runs.hpp>
+#include <utils/color_writer.hpp>
+
+namespace proud_color_sorter::benchmarks {
+
+namespace {
+
+constexpr std::size_t kSequencesCount = 1024;
+
+/// Formats \ref kSequencesCount sequences of `state.range(0)` colors, as the app prints them.
+void BM_AppendSequence(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  utils::ColorWriter writer;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kSequencesCount; ++i) {
+      writer.AppendSequence("Sorted colors", colors.data(), colors.data() + colors.size());
+    }
+
+    benchmark::DoNotOptimize(writer.View().data());
+    writer.Clear();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(kSequencesCount));
+}
+
+void BM_AppendSummary(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  ColorOrder order;
+  order.Set(Color::kBlue, 0);
+  order.Set(Color::kRed, 1);
+  order.Set(Color::kGreen, 2);
+  const SortedRuns runs{CountColorsSimd(colors.data(), colors.data() + colors.size()), order};
+  utils::ColorWriter writer;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kSequencesCount; ++i) {
+      writer.AppendSummary("Sorted colors", runs);
+    }
+
+    benchmark::DoNotOptimize(writer.View().data());
+    writer.Clear();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kSequencesCount));
+}
+
+}  // namespace
+
+BENCHMARK(BM_AppendSequence)->RangeMultiplier(10)->Range(10, 10'000);
+BENCHMARK(BM_AppendSummary)->RangeMultiplier(10)->Range(10, 10'000);
+
+}  // namespace proud_color_sorter::benchmarks
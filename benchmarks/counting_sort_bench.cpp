@@ -0,0 +1,451 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <color.hpp>
+#include <color_samples.hpp>
+#include <color_sequence_batch.hpp>
+#include <counting_sort.hpp>
+#include <order.hpp>
+#include <small_counting_sort.hpp>
+#include <utils/random_generator.hpp>
+
+namespace proud_color_sorter::benchmarks {
+
+namespace {
+
+using HashColorOrder = Order<Color, kColorSize, HashRankStorage<Color, kColorSize>>;
+
+/// Layout of colors sorted by \ref BM_CountingSortDistribution.
+enum class Distribution : std::int64_t {
+  kUniform,
+  /// All colors are the same.
+  kSingleColor,
+  /// 90% red, 9% green and 1% blue.
+  kSkewed,
+  /// Already sorted by the benchmarked order.
+  kSorted,
+  /// Sorted by the reversed order.
+  kReversed,
+};
+
+constexpr std::array<const char*, 5> kDistributionNames{"uniform", "single_color", "skewed", "sorted", "reversed"};
+
+/// Generates \a size colors with \a distribution using the bulk generator, so even 10^9 colors take seconds.
+std::vector<Color> GenerateColors(const std::size_t size, const Distribution distribution) {
+  constexpr std::array<std::size_t, kColorSize> kSkewedCounts{90, 9, 1};
+
+  std::vector<Color> colors(size);
+
+  switch (distribution) {
+    case Distribution::kUniform:
+      utils::ColorGenerator{}.Generate(colors.data(), colors.data() + colors.size());
+      break;
+
+    case Distribution::kSingleColor:
+      std::fill(colors.begin(), colors.end(), Color::kGreen);
+      break;
+
+    case Distribution::kSkewed: {
+      utils::Xoshiro256StarStar engine{size};
+
+      for (Color& color : colors) {
+        const std::uint64_t percent = engine() % 100;
+        color = percent < kSkewedCounts[0] ? Color::kRed
+                : percent < kSkewedCounts[0] + kSkewedCounts[1] ? Color::kGreen
+                                                                  : Color::kBlue;
+      }
+
+      break;
+    }
+
+    case Distribution::kSorted:
+    case Distribution::kReversed: {
+      const std::size_t run_size = size / kColorSize;
+      // The benchmarked order is blue, red, green.
+      const std::array<Color, kColorSize> runs = distribution == Distribution::kSorted
+                                                     ? std::array{Color::kBlue, Color::kRed, Color::kGreen}
+                                                     : std::array{Color::kGreen, Color::kRed, Color::kBlue};
+      auto out = colors.begin();
+
+      for (std::size_t i = 0; i < kColorSize; ++i) {
+        const auto run_end = i + 1 == kColorSize ? colors.end() : out + static_cast<std::ptrdiff_t>(run_size);
+        out = std::fill_n(out, run_end - out, runs[i]);
+      }
+
+      break;
+    }
+  }
+
+  return colors;
+}
+
+/// The counting sort as it was written before \ref Order got flat rank tables, parametrized by the order type.
+template <typename OrderType>
+std::vector<Color> ReferenceCountingSort(const std::vector<Color>& colors, const OrderType& order) {
+  std::array<std::size_t, kColorSize> color_count{};
+
+  for (const Color color : colors) {
+    ++color_count[order.GetRank(color)];
+  }
+
+  std::vector<Color> sorted_colors;
+  sorted_colors.reserve(colors.size());
+
+  for (const Color color : order) {
+    for (std::size_t i = 0; i < color_count[order.GetRank(color)]; ++i) {
+      sorted_colors.emplace_back(color);
+    }
+  }
+
+  return sorted_colors;
+}
+
+template <typename OrderType>
+void BM_ReferenceCountingSort(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  const auto order = samples::MakeOrder<OrderType>();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ReferenceCountingSort(colors, order));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CountingSort(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  const auto order = samples::MakeOrder();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CountingSort(colors, order));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Sorts `state.range(0)` colors with the layout `state.range(1)`, see \ref Distribution.
+void BM_CountingSortDistribution(benchmark::State& state) {
+  const auto distribution = static_cast<Distribution>(state.range(1));
+  const auto colors = GenerateColors(static_cast<std::size_t>(state.range(0)), distribution);
+  const auto order = samples::MakeOrder();
+  std::vector<Color> sorted_colors(colors.size());
+
+  for (auto _ : state) {
+    CountingSort(colors.data(), colors.data() + colors.size(), order, sorted_colors.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetLabel(kDistributionNames[static_cast<std::size_t>(distribution)]);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Sorts `state.range(0)` bytes of a \a DomainSize-value domain with the generic kernel.
+template <std::size_t DomainSize>
+void BM_SmallCountingSort(benchmark::State& state) {
+  utils::Xoshiro256StarStar engine{DomainSize};
+  std::vector<std::uint8_t> keys(static_cast<std::size_t>(state.range(0)));
+
+  for (std::uint8_t& key : keys) {
+    key = static_cast<std::uint8_t>(engine() % DomainSize);
+  }
+
+  Order<std::uint8_t, DomainSize> order;
+
+  for (std::size_t i = 0; i < DomainSize; ++i) {
+    order.Set(static_cast<std::uint8_t>(i), DomainSize - 1 - i);
+  }
+
+  std::vector<std::uint8_t> sorted_keys(keys.size());
+
+  for (auto _ : state) {
+    SmallCountingSort<DomainSize>(keys.data(), keys.data() + keys.size(), order, sorted_keys.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Record of \a Size bytes keyed by its color.
+template <std::size_t Size>
+struct Record {
+  Color color;
+  std::array<char, Size - 1> payload;
+};
+
+template <std::size_t Size>
+std::vector<Record<Size>> GenerateRecords(const std::size_t size) {
+  const auto colors = samples::GenerateColors(size);
+  std::vector<Record<Size>> records(size);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    records[i].color = colors[i];
+  }
+
+  return records;
+}
+
+/// Sorts records with `std::sort` and \ref Order::IsLess, as suggested by the note of \ref CountingSort.
+template <std::size_t Size>
+void BM_StdSortRecords(benchmark::State& state) {
+  const auto records = GenerateRecords<Size>(static_cast<std::size_t>(state.range(0)));
+  const auto order = samples::MakeOrder();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto sorted = records;
+    state.ResumeTiming();
+
+    std::sort(sorted.begin(), sorted.end(), [&order](const Record<Size>& lhs, const Record<Size>& rhs) {
+      return order.IsLess(lhs.color, rhs.color);
+    });
+    benchmark::DoNotOptimize(sorted.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <std::size_t Size>
+void BM_CountingSortBy(benchmark::State& state) {
+  const auto records = GenerateRecords<Size>(static_cast<std::size_t>(state.range(0)));
+  const auto order = samples::MakeOrder();
+  std::vector<Record<Size>> sorted(records.size());
+
+  for (auto _ : state) {
+    CountingSortBy(records.data(), records.data() + records.size(), order, &Record<Size>::color, sorted.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Scatters records a record at a time regardless of their size, the baseline of the staged scatter.
+template <std::size_t Size>
+void BM_ScatterRecordsDirect(benchmark::State& state) {
+  const auto records = GenerateRecords<Size>(static_cast<std::size_t>(state.range(0)));
+  const auto order = samples::MakeOrder();
+  std::vector<Record<Size>> sorted(records.size());
+  auto key = &Record<Size>::color;
+
+  for (auto _ : state) {
+    ColorHistogram histogram{};
+
+    for (const auto& record : records) {
+      ++histogram[static_cast<std::size_t>(record.color)];
+    }
+
+    std::array<Record<Size>*, kColorSize> next{};
+    Record<Size>* out = sorted.data();
+
+    for (const Color color : order) {
+      next[static_cast<std::size_t>(color)] = out;
+      out += histogram[static_cast<std::size_t>(color)];
+    }
+
+    detail::ScatterRecords(records.data(), records.data() + records.size(), key, next);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Sorts `state.range(0)` colors under every order with a \ref CountingSort call per order.
+void BM_CountingSortEveryOrder(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::vector<Color>> sorted_colors(kColorOrderCount, std::vector<Color>(colors.size()));
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kColorOrderCount; ++i) {
+      CountingSort(colors.data(), colors.data() + colors.size(), kAllColorOrders[i], sorted_colors[i].data());
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Same as \ref BM_CountingSortEveryOrder, but the input is counted once.
+void BM_CountingSortMultiOrder(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::vector<Color>> sorted_colors(kColorOrderCount, std::vector<Color>(colors.size()));
+  std::vector<Color*> outs;
+
+  for (auto& sorted : sorted_colors) {
+    outs.push_back(sorted.data());
+  }
+
+  for (auto _ : state) {
+    CountingSortMultiOrder(colors.data(), colors.data() + colors.size(), kAllColorOrders.data(),
+                           kAllColorOrders.data() + kAllColorOrders.size(), outs.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Sorts `state.range(0)` short sequences in place, each one with \ref SortInPlace or its kernel compiled for the
+/// order if \a IsSpecialized.
+template <bool IsSpecialized>
+void BM_SortInPlaceSequences(benchmark::State& state) {
+  constexpr std::size_t kSequenceSize = 64;
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)) * kSequenceSize);
+  const auto order = samples::MakeOrder();
+  const ColorSortKernels& kernels = GetColorSortKernels(order);
+  std::vector<Color> sorted_colors(colors.size());
+
+  for (auto _ : state) {
+    sorted_colors = colors;
+
+    for (Color* first = sorted_colors.data(); first != sorted_colors.data() + sorted_colors.size();
+         first += kSequenceSize) {
+      if constexpr (IsSpecialized) {
+        kernels.sort_in_place(first, first + kSequenceSize);
+      } else {
+        SortInPlace(first, first + kSequenceSize, order);
+      }
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Same as \ref BM_SortInPlaceSequences, but with \ref CountingSort.
+template <bool IsSpecialized>
+void BM_CountingSortSequences(benchmark::State& state) {
+  constexpr std::size_t kSequenceSize = 64;
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)) * kSequenceSize);
+  const auto order = samples::MakeOrder();
+  const ColorSortKernels& kernels = GetColorSortKernels(order);
+  std::vector<Color> sorted_colors(colors.size());
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < colors.size(); i += kSequenceSize) {
+      if constexpr (IsSpecialized) {
+        kernels.counting_sort(colors.data() + i, colors.data() + i + kSequenceSize, sorted_colors.data() + i);
+      } else {
+        CountingSort(colors.data() + i, colors.data() + i + kSequenceSize, order, sorted_colors.data() + i);
+      }
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_EmplaceBackRuns(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  const auto order = samples::MakeOrder();
+  const auto histogram = CountColorsSimd(colors.data(), colors.data() + colors.size());
+
+  for (auto _ : state) {
+    std::vector<Color> sorted_colors;
+    sorted_colors.reserve(colors.size());
+
+    // The run writer `CountingSort` used before `FillSortedColors`.
+    for (const Color color : order) {
+      for (std::size_t i = histogram[static_cast<std::size_t>(color)]; i > 0; --i) {
+        sorted_colors.emplace_back(color);
+      }
+    }
+
+    benchmark::DoNotOptimize(sorted_colors.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_FillSortedColors(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)));
+  const auto order = samples::MakeOrder();
+  const auto histogram = CountColorsSimd(colors.data(), colors.data() + colors.size());
+  std::vector<Color> sorted_colors(colors.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FillSortedColors(histogram, order, sorted_colors.data()));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/// Sorts `state.range(0)` short sequences, each one living in its own vector.
+void BM_CountingSortSequenceVectors(benchmark::State& state) {
+  constexpr std::size_t kSequenceSize = 16;
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)) * kSequenceSize);
+  const auto order = samples::MakeOrder();
+  std::vector<std::vector<Color>> sequences;
+
+  for (std::size_t i = 0; i < colors.size(); i += kSequenceSize) {
+    sequences.emplace_back(colors.begin() + static_cast<std::ptrdiff_t>(i),
+                           colors.begin() + static_cast<std::ptrdiff_t>(i + kSequenceSize));
+  }
+
+  for (auto _ : state) {
+    for (auto& sequence : sequences) {
+      CountingSort(sequence.data(), sequence.data() + sequence.size(), order, sequence.data());
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Sorts `state.range(0)` short sequences stored back to back in \ref ColorSequenceBatch.
+void BM_CountingSortSequenceBatch(benchmark::State& state) {
+  constexpr std::size_t kSequenceSize = 16;
+  const auto colors = samples::GenerateColors(static_cast<std::size_t>(state.range(0)) * kSequenceSize);
+  const auto order = samples::MakeOrder();
+  ColorSequenceBatch batch;
+  batch.Reserve(static_cast<std::size_t>(state.range(0)), colors.size());
+
+  for (std::size_t i = 0; i < colors.size(); i += kSequenceSize) {
+    batch.Add(colors.data() + i, colors.data() + i + kSequenceSize);
+  }
+
+  for (auto _ : state) {
+    CountingSort(batch, order);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ReferenceCountingSort, HashColorOrder)->RangeMultiplier(16)->Range(16, 1 << 24);
+BENCHMARK_TEMPLATE(BM_ReferenceCountingSort, ColorOrder)->RangeMultiplier(16)->Range(16, 1 << 24);
+BENCHMARK(BM_CountingSort)->RangeMultiplier(16)->Range(16, 1 << 24);
+BENCHMARK(BM_CountingSortDistribution)
+    ->ArgsProduct({benchmark::CreateRange(10, 1'000'000'000, 10),
+                   benchmark::CreateDenseRange(0, static_cast<std::int64_t>(kDistributionNames.size()) - 1, 1)})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SmallCountingSort, kColorSize)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK_TEMPLATE(BM_SmallCountingSort, 16)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK_TEMPLATE(BM_SmallCountingSort, 256)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK_TEMPLATE(BM_StdSortRecords, 8)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_StdSortRecords, 64)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_CountingSortBy, 8)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_CountingSortBy, 64)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK_TEMPLATE(BM_CountingSortBy, 256)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK_TEMPLATE(BM_ScatterRecordsDirect, 64)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK_TEMPLATE(BM_ScatterRecordsDirect, 256)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_CountingSortEveryOrder)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_CountingSortMultiOrder)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortInPlaceSequences, false)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_SortInPlaceSequences, true)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_CountingSortSequences, false)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_CountingSortSequences, true)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_EmplaceBackRuns)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_FillSortedColors)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_CountingSortSequenceVectors)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_CountingSortSequenceBatch)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+}  // namespace proud_color_sorter::benchmarks
@@ -0,0 +1,64 @@
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <mpsc_bounded_queue.hpp>
+#include <mpsc_queue.hpp>
+
+namespace proud_color_sorter::benchmarks {
+
+namespace {
+
+constexpr std::int64_t kElementsPerProducer = 100'000;
+constexpr std::size_t kBoundedQueueCapacity = 1024;
+
+/// Adapts \ref MPSCUnboundedBlockingQueue to the constructor of the bounded one.
+class UnboundedQueue : public MPSCUnboundedBlockingQueue<std::int64_t> {
+ public:
+  explicit UnboundedQueue(std::size_t /*capacity*/) {}
+};
+
+template <typename Queue>
+void BM_QueueThroughput(benchmark::State& state) {
+  const auto producers_count = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    auto queue = std::make_unique<Queue>(kBoundedQueueCapacity);
+    std::vector<std::thread> producers;
+
+    for (std::size_t i = 0; i < producers_count; ++i) {
+      producers.emplace_back([&queue]() {
+        for (std::int64_t element = 0; element < kElementsPerProducer; ++element) {
+          queue->Put(element);
+        }
+      });
+    }
+
+    std::int64_t sum = 0;
+
+    for (std::size_t i = 0; i < producers_count * kElementsPerProducer; ++i) {
+      sum += queue->Take().value();
+    }
+
+    benchmark::DoNotOptimize(sum);
+
+    for (auto& producer : producers) {
+      producer.join();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0) * kElementsPerProducer);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_QueueThroughput, UnboundedQueue)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueThroughput, MPSCBoundedLockFreeQueue<std::int64_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+
+}  // namespace proud_color_sorter::benchmarks
@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <color.hpp>
+#include <color_samples.hpp>
+#include <counting_sort.hpp>
+#include <order.hpp>
+
+namespace proud_color_sorter::benchmarks {
+
+namespace {
+
+using HashColorOrder = Order<Color, kColorSize, HashRankStorage<Color, kColorSize>>;
+
+constexpr std::size_t kColorsCount = 1 << 16;
+
+template <typename OrderType>
+void BM_GetRank(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(kColorsCount);
+  const auto order = samples::MakeOrder<OrderType>();
+
+  for (auto _ : state) {
+    std::size_t rank_sum = 0;
+
+    for (const Color color : colors) {
+      rank_sum += order.GetRank(color);
+    }
+
+    benchmark::DoNotOptimize(rank_sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kColorsCount));
+}
+
+/// Compares neighbouring colors, as a comparison sort would.
+template <typename OrderType>
+void BM_IsLess(benchmark::State& state) {
+  const auto colors = samples::GenerateColors(kColorsCount + 1);
+  const auto order = samples::MakeOrder<OrderType>();
+
+  for (auto _ : state) {
+    std::size_t less_count = 0;
+
+    for (std::size_t i = 0; i < kColorsCount; ++i) {
+      less_count += static_cast<std::size_t>(order.IsLess(colors[i], colors[i + 1]));
+    }
+
+    benchmark::DoNotOptimize(less_count);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kColorsCount));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_GetRank, ColorOrder);
+BENCHMARK_TEMPLATE(BM_GetRank, HashColorOrder);
+BENCHMARK_TEMPLATE(BM_IsLess, ColorOrder);
+BENCHMARK_TEMPLATE(BM_IsLess, HashColorOrder);
+
+}  // namespace proud_color_sorter::benchmarks
@@ -0,0 +1,47 @@
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <color.hpp>
+#include <utils/random_generator.hpp>
+
+namespace proud_color_sorter::benchmarks {
+
+namespace {
+
+void BM_RandomGeneratorPerColor(benchmark::State& state) {
+  utils::RandomGenerator<std::uint64_t> color_generator{0, kColorSize - 1};
+  std::vector<Color> colors(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    for (Color& color : colors) {
+      color = static_cast<Color>(color_generator.Generate());
+    }
+
+    benchmark::DoNotOptimize(colors.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ColorGeneratorBulk(benchmark::State& state) {
+  utils::ColorGenerator color_generator;
+  std::vector<Color> colors(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    color_generator.Generate(colors.data(), colors.data() + colors.size());
+    benchmark::DoNotOptimize(colors.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_RandomGeneratorPerColor)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_ColorGeneratorBulk)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+}  // namespace proud_color_sorter::benchmarks
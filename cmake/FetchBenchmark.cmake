@@ -0,0 +1,16 @@
+include_guard()
+
+find_package(benchmark QUIET)
+
+if (NOT benchmark_FOUND)
+  include(FetchContent)
+  FetchContent_Declare(
+    benchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG v1.7.1
+  )
+
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE INTERNAL "")
+  FetchContent_MakeAvailable(benchmark)
+endif()
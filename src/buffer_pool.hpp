@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace proud_color_sorter {
+
+/// Pool of reusable \c std::vector buffers, so buffers are passed around in a loop instead of being allocated and freed
+/// on every use.
+///
+/// Thread-safe: buffers may be acquired and released by different threads.
+///
+/// Buffers acquired from the pool are tracked by their memory, so a buffer, which the caller has grown, e. g. by
+/// reading into it, is told apart on \ref Release and counted as an allocation too. Node memory of the tracking set
+/// is recycled, so tracking doesn't allocate either once the number of buffers in flight stops growing. A buffer, which
+/// is destroyed instead of being released, stays tracked until the pool is destroyed.
+///
+/// Buffers are `std::vector<T, Allocator>`, so an allocator, which doesn't initialize elements, saves zero-filling of
+/// buffers, which are written over anyway.
+template <typename T, typename Allocator = std::allocator<T>>
+class BufferPool {
+ public:
+  using Buffer = std::vector<T, Allocator>;
+
+  /// Counters of pool operations, \ref allocations is the number of heap allocations made by \ref Acquire, plus the
+  /// number of released buffers, which were grown after they were acquired or weren't acquired from the pool at all.
+  struct Stats {
+    std::size_t acquisitions = 0;
+    std::size_t allocations = 0;
+    std::size_t releases = 0;
+    std::size_t drops = 0;
+  };
+
+  /// Creates an empty pool, which keeps at most \a max_pooled released buffers and frees the others.
+  explicit BufferPool(std::size_t max_pooled);
+
+  BufferPool(const BufferPool& other) = delete;
+
+  BufferPool& operator=(const BufferPool& other) = delete;
+
+  ~BufferPool() = default;
+
+  /// Returns an empty buffer with capacity of at least \a min_capacity. Reuses a released buffer if there is any,
+  /// allocates only if the pool is empty or the reused buffer is too small. A grown buffer keeps its capacity once
+  /// released, so the pool ends up with buffers as large as the largest requests it has seen.
+  Buffer Acquire(std::size_t min_capacity);
+
+  /// Returns a \a buffer to the pool. Its elements are destroyed, but memory is kept for the next \ref Acquire.
+  void Release(Buffer buffer);
+
+  /// Returns counters of operations made so far.
+  [[nodiscard]] Stats GetStats() const;
+
+ private:
+  const std::size_t max_pooled_;
+  mutable std::mutex lock_;
+  std::vector<Buffer> buffers_;
+
+  /// Memory of acquired buffers, which aren't released yet. Buffers without memory aren't tracked.
+  std::pmr::unsynchronized_pool_resource lent_resource_;
+  std::pmr::unordered_set<const T*> lent_;
+
+  Stats stats_;
+};
+
+template <typename T, typename Allocator>
+BufferPool<T, Allocator>::BufferPool(const std::size_t max_pooled) : max_pooled_(max_pooled), lent_(&lent_resource_) {
+  buffers_.reserve(max_pooled_);
+  lent_.reserve(max_pooled_);
+}
+
+template <typename T, typename Allocator>
+typename BufferPool<T, Allocator>::Buffer BufferPool<T, Allocator>::Acquire(const std::size_t min_capacity) {
+  Buffer buffer;
+
+  {
+    std::lock_guard lock{lock_};
+    ++stats_.acquisitions;
+
+    if (!buffers_.empty()) {
+      buffer = std::move(buffers_.back());
+      buffers_.pop_back();
+    }
+
+    if (buffer.capacity() >= min_capacity) {
+      if (buffer.capacity() > 0) {
+        lent_.insert(buffer.data());
+      }
+
+      return buffer;
+    }
+
+    ++stats_.allocations;
+  }
+
+  // Memory is allocated outside of the lock, only the new address is registered under it.
+  buffer.reserve(min_capacity);
+  std::lock_guard lock{lock_};
+  lent_.insert(buffer.data());
+
+  return buffer;
+}
+
+template <typename T, typename Allocator>
+void BufferPool<T, Allocator>::Release(Buffer buffer) {
+  buffer.clear();
+  std::lock_guard lock{lock_};
+  ++stats_.releases;
+
+  // Memory of a grown buffer is new, so it isn't found among the lent ones.
+  if (buffer.capacity() > 0 && lent_.erase(buffer.data()) == 0) {
+    ++stats_.allocations;
+  }
+
+  if (buffers_.size() < max_pooled_ && buffer.capacity() > 0) {
+    buffers_.emplace_back(std::move(buffer));
+  } else {
+    ++stats_.drops;
+  }
+}
+
+template <typename T, typename Allocator>
+typename BufferPool<T, Allocator>::Stats BufferPool<T, Allocator>::GetStats() const {
+  std::lock_guard lock{lock_};
+  return stats_;
+}
+
+}  // namespace proud_color_sorter
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include <enum_traits.hpp>
+
 namespace proud_color_sorter {
 
 /// Should be up to date with \ref Color, else it will be UB to use the whole app.
@@ -14,4 +16,9 @@ enum class Color : std::uint8_t {
   kBlue = 2,
 };
 
-}  // namespace proud_color_sorter
\ No newline at end of file
+template <>
+struct DenseEnumTraits<Color> {
+  static constexpr std::size_t kSize = kColorSize;
+};
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,242 @@
+#include <color_frame.hpp>
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace proud_color_sorter {
+
+namespace detail {
+
+using Crc32cKernel = std::uint32_t (*)(std::uint32_t, const unsigned char*, std::size_t) noexcept;
+
+/// Reflected Castagnoli polynomial.
+constexpr std::uint32_t kCrc32cPolynomial = 0x82F63B78;
+
+constexpr std::array<std::uint32_t, 256> MakeCrc32cTable() {
+  std::array<std::uint32_t, 256> table{};
+
+  for (std::uint32_t i = 0; i < table.size(); ++i) {
+    std::uint32_t crc = i;
+
+    for (std::size_t bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) != 0 ? kCrc32cPolynomial : 0);
+    }
+
+    table[i] = crc;
+  }
+
+  return table;
+}
+
+constexpr auto kCrc32cTable = MakeCrc32cTable();
+
+std::uint32_t Crc32cScalar(std::uint32_t crc, const unsigned char* data, const std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = kCrc32cTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+
+  return crc;
+}
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+
+__attribute__((target("sse4.2"))) std::uint32_t Crc32cSse42(std::uint32_t crc, const unsigned char* data,
+                                                            std::size_t size) noexcept {
+#ifdef __x86_64__
+  std::uint64_t crc64 = crc;
+
+  for (; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t), data += sizeof(std::uint64_t)) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+
+  crc = static_cast<std::uint32_t>(crc64);
+#endif
+
+  for (; size > 0; --size, ++data) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+
+  return crc;
+}
+
+#endif
+
+Crc32cKernel SelectCrc32cKernel() noexcept {
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("sse4.2")) {
+    return Crc32cSse42;
+  }
+#endif
+
+  return Crc32cScalar;
+}
+
+/// Packs 8 colors, a byte each, to 2 bytes: every shift moves the next color next to the previous one.
+std::uint16_t PackEightColors(const Color* colors) noexcept {
+  // The word is assembled little endian on any host, compilers turn this into a single load on little endian ones.
+  std::uint64_t word = 0;
+
+  for (std::size_t i = 0; i < 8; ++i) {
+    word |= static_cast<std::uint64_t>(colors[i]) << (8 * i);
+  }
+
+  word |= word >> 6;
+  word |= word >> 12;
+  return static_cast<std::uint16_t>((word & 0xFF) | ((word >> 24) & 0xFF00));
+}
+
+/// Maps a packed byte to its 4 colors.
+constexpr std::array<std::array<Color, 4>, 256> MakeUnpackTable() {
+  std::array<std::array<Color, 4>, 256> table{};
+
+  for (std::size_t byte = 0; byte < table.size(); ++byte) {
+    for (std::size_t i = 0; i < 4; ++i) {
+      table[byte][i] = static_cast<Color>((byte >> (2 * i)) & 0b11);
+    }
+  }
+
+  return table;
+}
+
+constexpr auto kUnpackTable = MakeUnpackTable();
+
+/// Has the lowest bit of every 2-bit color slot set.
+constexpr std::uint8_t kLowSlotBits = 0x55;
+
+void WriteLittleEndian(const std::uint64_t value, const std::size_t size, char* out) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+std::uint32_t ReadLittleEndian(const char* data, const std::size_t size) noexcept {
+  std::uint32_t value = 0;
+
+  for (std::size_t i = 0; i < size; ++i) {
+    value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+  }
+
+  return value;
+}
+
+void PackColors(const Color* first, const Color* last, char* out) noexcept {
+  for (; last - first >= 8; first += 8, out += 2) {
+    const std::uint16_t packed = PackEightColors(first);
+    out[0] = static_cast<char>(packed & 0xFF);
+    out[1] = static_cast<char>(packed >> 8);
+  }
+
+  const auto tail_size = static_cast<std::size_t>(last - first);
+  unsigned word = 0;
+
+  for (std::size_t i = 0; i < tail_size; ++i) {
+    word |= static_cast<unsigned>(first[i]) << (2 * i);
+  }
+
+  for (std::size_t i = 0; i < (tail_size + 3) / 4; ++i) {
+    out[i] = static_cast<char>((word >> (8 * i)) & 0xFF);
+  }
+}
+
+}  // namespace detail
+
+char* EncodeFrame(const Color* first, const Color* last, const bool is_packed, char* out) noexcept {
+  const auto size = static_cast<std::size_t>(last - first);
+  char* payload = out + kFrameHeaderSize;
+  const std::size_t payload_size = FramePayloadSize(size, is_packed);
+
+  if (is_packed) {
+    detail::PackColors(first, last, payload);
+  } else if (size > 0) {
+    std::memcpy(payload, first, size);
+  }
+
+  detail::WriteLittleEndian(kFrameMagic, 2, out);
+  out[2] = static_cast<char>(kFrameVersion);
+  out[3] = static_cast<char>(is_packed ? kFramePackedFlag : 0);
+  detail::WriteLittleEndian(size, 4, out + 4);
+  detail::WriteLittleEndian(Crc32c(payload, payload_size), 4, out + 8);
+
+  return payload + payload_size;
+}
+
+FrameHeader DecodeFrameHeader(const char* data) {
+  if (detail::ReadLittleEndian(data, 2) != kFrameMagic) {
+    throw std::runtime_error{"Invalid frame magic"};
+  }
+
+  FrameHeader header;
+  header.version = static_cast<std::uint8_t>(data[2]);
+
+  if (header.version != kFrameVersion) {
+    throw std::runtime_error{"Unsupported frame version " + std::to_string(header.version)};
+  }
+
+  const auto flags = static_cast<std::uint8_t>(data[3]);
+
+  if ((flags & ~kFramePackedFlag) != 0) {
+    throw std::runtime_error{"Unknown frame flags " + std::to_string(flags)};
+  }
+
+  header.is_packed = (flags & kFramePackedFlag) != 0;
+  header.size = detail::ReadLittleEndian(data + 4, 4);
+  header.checksum = detail::ReadLittleEndian(data + 8, 4);
+
+  return header;
+}
+
+void DecodeFramePayload(const FrameHeader& header, const char* payload, Color* out) {
+  const std::size_t payload_size = FramePayloadSize(header.size, header.is_packed);
+
+  if (Crc32c(payload, payload_size) != header.checksum) {
+    throw std::runtime_error{"Frame checksum mismatch"};
+  }
+
+  const auto* bytes = reinterpret_cast<const unsigned char*>(payload);
+  unsigned char invalid = 0;
+
+  if (header.is_packed) {
+    const std::size_t full_bytes = header.size / 4;
+
+    for (std::size_t i = 0; i < full_bytes; ++i, out += 4) {
+      // A color is invalid if both of its bits are set.
+      invalid |= bytes[i] & (bytes[i] >> 1) & detail::kLowSlotBits;
+      std::memcpy(out, detail::kUnpackTable[bytes[i]].data(), 4);
+    }
+
+    for (std::size_t i = 0; i < header.size % 4; ++i) {
+      const auto color = static_cast<unsigned char>((bytes[full_bytes] >> (2 * i)) & 0b11);
+      invalid |= color == kColorSize ? 1 : 0;
+      out[i] = static_cast<Color>(color);
+    }
+  } else {
+    for (std::size_t i = 0; i < header.size; ++i) {
+      invalid |= bytes[i] >= kColorSize ? 1 : 0;
+    }
+
+    if (header.size > 0 && reinterpret_cast<const char*>(out) != payload) {
+      std::memcpy(out, payload, header.size);
+    }
+  }
+
+  if (invalid != 0) {
+    throw std::runtime_error{"Invalid color in frame"};
+  }
+}
+
+std::uint32_t Crc32c(const char* data, const std::size_t size) noexcept {
+  static const detail::Crc32cKernel kKernel = detail::SelectCrc32cKernel();
+  return ~kKernel(~std::uint32_t{0}, reinterpret_cast<const unsigned char*>(data), size);
+}
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <color.hpp>
+#include <platform.hpp>
+
+namespace proud_color_sorter {
+
+/// Binary frame of a color sequence.
+///
+/// A frame is a 12-byte header followed by a payload. All numbers are little-endian.
+///
+/// | Offset | Size | Field                                                       |
+/// |--------|------|-------------------------------------------------------------|
+/// | 0      | 2    | Magic \ref kFrameMagic                                      |
+/// | 2      | 1    | Format version \ref kFrameVersion                           |
+/// | 3      | 1    | Flags, \ref kFramePackedFlag is the only one defined        |
+/// | 4      | 4    | Number of colors                                            |
+/// | 8      | 4    | CRC-32C of the payload                                      |
+///
+/// Payload has a byte per color equal to its value, or, if the frame is packed, 4 colors per byte with color \c i in
+/// bits `[2 * (i % 4), 2 * (i % 4) + 2)` of byte `i / 4`. Unused bits of the last byte are zero.
+struct FrameHeader {
+  std::uint8_t version = 0;
+  bool is_packed = false;
+  std::uint32_t size = 0;
+  std::uint32_t checksum = 0;
+};
+
+constexpr std::uint16_t kFrameMagic = 0x4350;  // "PC"
+constexpr std::uint8_t kFrameVersion = 1;
+constexpr std::uint8_t kFramePackedFlag = 0x01;
+constexpr std::size_t kFrameHeaderSize = 12;
+
+/// Returns the size of payload of a frame of \a size colors.
+constexpr std::size_t FramePayloadSize(const std::size_t size, const bool is_packed) noexcept {
+  return is_packed ? (size + 3) / 4 : size;
+}
+
+/// Returns the size of a whole frame of \a size colors.
+constexpr std::size_t FrameSize(const std::size_t size, const bool is_packed) noexcept {
+  return kFrameHeaderSize + FramePayloadSize(size, is_packed);
+}
+
+/// Encodes colors from range [\a first, \a last) as a frame to \a out, which must have room for \ref FrameSize bytes.
+/// Returns pointer to the byte after the frame.
+/// Sequence must be shorter than 2^32 colors.
+char* EncodeFrame(const Color* first, const Color* last, bool is_packed, char* out) noexcept;
+
+/// Decodes a frame header from \ref kFrameHeaderSize bytes at \a data.
+/// Throws \c std::runtime_error if the magic, the version or the flags are unknown.
+FrameHeader DecodeFrameHeader(const char* data);
+
+/// Decodes \a payload of a frame with \a header to \a out, which must have room for `header.size` colors.
+/// A plain payload may be decoded in place, i. e. \a out may point to \a payload.
+/// Throws \c std::runtime_error if the checksum doesn't match or a color is invalid.
+void DecodeFramePayload(const FrameHeader& header, const char* payload, Color* out);
+
+/// Returns CRC-32C (Castagnoli) of \a size bytes at \a data, computed with SSE4.2 instructions if available.
+std::uint32_t Crc32c(const char* data, std::size_t size) noexcept;
+
+namespace detail {
+
+/// Kernels selected by \ref Crc32c. Each one updates \a crc, which is neither pre- nor post-inverted, with \a size
+/// bytes at \a data.
+std::uint32_t Crc32cScalar(std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept;
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+
+/// May be called only if the CPU supports SSE4.2.
+__attribute__((target("sse4.2"))) std::uint32_t Crc32cSse42(std::uint32_t crc, const unsigned char* data,
+                                                            std::size_t size) noexcept;
+
+#endif
+
+}  // namespace detail
+
+}  // namespace proud_color_sorter
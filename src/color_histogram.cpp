@@ -0,0 +1,186 @@
+#include <color_histogram.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace proud_color_sorter {
+
+namespace detail {
+
+using CountColorsKernel = ColorHistogram (*)(const Color*, const Color*) noexcept;
+
+/// Number of colors \ref CountColorsChecked counts and checks at once, small enough to stay in L1 cache.
+constexpr std::size_t kCheckedBlockSize = std::size_t{1} << 14;
+
+/// Returns \c true if every byte of range [\a first, \a last) is a color. Compilers vectorize the loop with byte-wise
+/// maximum.
+bool AreColors(const Color* first, const Color* last) noexcept {
+  std::uint8_t max_value = 0;
+
+  for (const Color* it = first; it != last; ++it) {
+    max_value = std::max(max_value, static_cast<std::uint8_t>(*it));
+  }
+
+  return max_value < kColorSize;
+}
+
+/// Builds a histogram from the number of red and green colors. Blue ones are the rest, since \ref Color has no other
+/// values.
+ColorHistogram MakeHistogram(const std::size_t size, const std::size_t red_count,
+                             const std::size_t green_count) noexcept {
+  ColorHistogram histogram{};
+  histogram[static_cast<std::size_t>(Color::kRed)] = red_count;
+  histogram[static_cast<std::size_t>(Color::kGreen)] = green_count;
+  histogram[static_cast<std::size_t>(Color::kBlue)] = size - red_count - green_count;
+  return histogram;
+}
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+
+// Both kernels accumulate comparison results in per-byte counters: `cmpeq` yields 0xFF (-1) for equal bytes, so
+// subtracting it increments the counter. Byte counters overflow after 255 blocks, so they are widened with `sad`
+// into 64-bit lanes before that.
+constexpr std::size_t kMaxBlocksPerBatch = 255;
+
+__attribute__((target("avx2"))) std::size_t HorizontalSum(const __m256i lanes) noexcept {
+  alignas(32) std::array<std::uint64_t, 4> sums{};
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sums.data()), lanes);
+  return static_cast<std::size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+}
+
+__attribute__((target("avx2"))) ColorHistogram CountColorsAvx2(const Color* first, const Color* last) noexcept {
+  constexpr std::size_t kBlockSize = sizeof(__m256i);
+
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i red = _mm256_set1_epi8(static_cast<char>(Color::kRed));
+  const __m256i green = _mm256_set1_epi8(static_cast<char>(Color::kGreen));
+
+  const std::size_t size = static_cast<std::size_t>(last - first);
+  std::size_t red_count = 0;
+  std::size_t green_count = 0;
+  const Color* it = first;
+
+  while (static_cast<std::size_t>(last - it) >= kBlockSize) {
+    const std::size_t blocks = std::min(static_cast<std::size_t>(last - it) / kBlockSize, kMaxBlocksPerBatch);
+    __m256i red_acc = zero;
+    __m256i green_acc = zero;
+
+    for (std::size_t i = 0; i < blocks; ++i, it += kBlockSize) {
+      const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+      red_acc = _mm256_sub_epi8(red_acc, _mm256_cmpeq_epi8(block, red));
+      green_acc = _mm256_sub_epi8(green_acc, _mm256_cmpeq_epi8(block, green));
+    }
+
+    red_count += HorizontalSum(_mm256_sad_epu8(red_acc, zero));
+    green_count += HorizontalSum(_mm256_sad_epu8(green_acc, zero));
+  }
+
+  const auto tail = CountColorsScalar(it, last);
+  red_count += tail[static_cast<std::size_t>(Color::kRed)];
+  green_count += tail[static_cast<std::size_t>(Color::kGreen)];
+
+  return MakeHistogram(size, red_count, green_count);
+}
+
+__attribute__((target("sse2"))) std::size_t HorizontalSum(const __m128i lanes) noexcept {
+  alignas(16) std::array<std::uint64_t, 2> sums{};
+  _mm_store_si128(reinterpret_cast<__m128i*>(sums.data()), lanes);
+  return static_cast<std::size_t>(sums[0] + sums[1]);
+}
+
+__attribute__((target("sse2"))) ColorHistogram CountColorsSse2(const Color* first, const Color* last) noexcept {
+  constexpr std::size_t kBlockSize = sizeof(__m128i);
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i red = _mm_set1_epi8(static_cast<char>(Color::kRed));
+  const __m128i green = _mm_set1_epi8(static_cast<char>(Color::kGreen));
+
+  const std::size_t size = static_cast<std::size_t>(last - first);
+  std::size_t red_count = 0;
+  std::size_t green_count = 0;
+  const Color* it = first;
+
+  while (static_cast<std::size_t>(last - it) >= kBlockSize) {
+    const std::size_t blocks = std::min(static_cast<std::size_t>(last - it) / kBlockSize, kMaxBlocksPerBatch);
+    __m128i red_acc = zero;
+    __m128i green_acc = zero;
+
+    for (std::size_t i = 0; i < blocks; ++i, it += kBlockSize) {
+      const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+      red_acc = _mm_sub_epi8(red_acc, _mm_cmpeq_epi8(block, red));
+      green_acc = _mm_sub_epi8(green_acc, _mm_cmpeq_epi8(block, green));
+    }
+
+    red_count += HorizontalSum(_mm_sad_epu8(red_acc, zero));
+    green_count += HorizontalSum(_mm_sad_epu8(green_acc, zero));
+  }
+
+  const auto tail = CountColorsScalar(it, last);
+  red_count += tail[static_cast<std::size_t>(Color::kRed)];
+  green_count += tail[static_cast<std::size_t>(Color::kGreen)];
+
+  return MakeHistogram(size, red_count, green_count);
+}
+
+#endif
+
+CountColorsKernel SelectCountColorsKernel() noexcept {
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return CountColorsAvx2;
+  }
+
+  if (__builtin_cpu_supports("sse2")) {
+    return CountColorsSse2;
+  }
+#endif
+
+  return CountColorsScalar;
+}
+
+}  // namespace detail
+
+ColorHistogram CountColorsScalar(const Color* first, const Color* last) noexcept {
+  ColorHistogram histogram{};
+
+  for (const Color* it = first; it != last; ++it) {
+    ++histogram[static_cast<std::size_t>(*it)];
+  }
+
+  return histogram;
+}
+
+ColorHistogram CountColorsSimd(const Color* first, const Color* last) noexcept {
+  static const detail::CountColorsKernel kKernel = detail::SelectCountColorsKernel();
+  return kKernel(first, last);
+}
+
+std::optional<ColorHistogram> CountColorsChecked(const Color* first, const Color* last) noexcept {
+  ColorHistogram histogram{};
+
+  while (first != last) {
+    const Color* block_last = first + std::min(static_cast<std::size_t>(last - first), detail::kCheckedBlockSize);
+    // Checked first: the scalar kernel would index past the histogram with an invalid byte.
+    if (!detail::AreColors(first, block_last)) {
+      return std::nullopt;
+    }
+
+    const auto block_histogram = CountColorsSimd(first, block_last);
+
+    for (std::size_t i = 0; i < kColorSize; ++i) {
+      histogram[i] += block_histogram[i];
+    }
+
+    first = block_last;
+  }
+
+  return histogram;
+}
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include <color.hpp>
+#include <platform.hpp>
+
+namespace proud_color_sorter {
+
+/// Number of occurrences of each color, indexed by the underlying value of \ref Color.
+using ColorHistogram = std::array<std::size_t, kColorSize>;
+
+/// Counts colors in range [\a first, \a last) one element per iteration.
+ColorHistogram CountColorsScalar(const Color* first, const Color* last) noexcept;
+
+/// Counts colors in range [\a first, \a last) with the widest SIMD kernel supported by the CPU.
+///
+/// The kernel (AVX2, SSE2 or \ref CountColorsScalar as a fallback) is selected once at runtime via CPUID.
+/// Returns the same result as \ref CountColorsScalar.
+ColorHistogram CountColorsSimd(const Color* first, const Color* last) noexcept;
+
+/// Counts colors in range [\a first, \a last) like \ref CountColorsSimd, but returns \c std::nullopt if any byte of
+/// the range isn't a color.
+///
+/// Meant for untrusted input, e. g. a mapped file. Every block is counted while it's still in cache after being
+/// checked, so memory is read once.
+std::optional<ColorHistogram> CountColorsChecked(const Color* first, const Color* last) noexcept;
+
+namespace detail {
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+
+/// Kernels selected by \ref CountColorsSimd. Each one may be called only if the CPU supports its instruction set.
+__attribute__((target("avx2"))) ColorHistogram CountColorsAvx2(const Color* first, const Color* last) noexcept;
+__attribute__((target("sse2"))) ColorHistogram CountColorsSse2(const Color* first, const Color* last) noexcept;
+
+#endif
+
+}  // namespace detail
+
+}  // namespace proud_color_sorter
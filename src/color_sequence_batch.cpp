@@ -0,0 +1,81 @@
+#include <color_sequence_batch.hpp>
+
+#include <utility>
+
+#include <color_histogram.hpp>
+
+namespace proud_color_sorter {
+
+namespace detail {
+
+/// Sequences shorter than this are counted by the scalar loop, which has no dispatch and setup overhead.
+constexpr std::size_t kSimdCountThreshold = 64;
+
+}  // namespace detail
+
+ColorSequenceBatch::ColorSequenceBatch(std::pmr::memory_resource* resource) : colors_(resource), offsets_(resource) {
+  offsets_.push_back(0);
+}
+
+ColorSequenceBatch::ColorSequenceBatch(const allocator_type& allocator) : ColorSequenceBatch(allocator.resource()) {}
+
+ColorSequenceBatch::ColorSequenceBatch(const ColorSequenceBatch& other, const allocator_type& allocator)
+    : colors_(other.colors_, allocator), offsets_(other.offsets_, allocator.resource()) {}
+
+ColorSequenceBatch::ColorSequenceBatch(ColorSequenceBatch&& other, const allocator_type& allocator)
+    : colors_(std::move(other.colors_), allocator), offsets_(std::move(other.offsets_), allocator.resource()) {
+  other.Clear();
+}
+
+ColorSequenceBatch& ColorSequenceBatch::operator=(ColorSequenceBatch&& other) {
+  colors_ = std::move(other.colors_);
+  offsets_ = std::move(other.offsets_);
+  other.Clear();
+  return *this;
+}
+
+void ColorSequenceBatch::Add(const Color* first, const Color* last) {
+  if (offsets_.empty()) {
+    offsets_.push_back(0);
+  }
+
+  colors_.insert(colors_.end(), first, last);
+  offsets_.push_back(colors_.size());
+}
+
+Color* ColorSequenceBatch::Add(const std::size_t size) {
+  if (offsets_.empty()) {
+    offsets_.push_back(0);
+  }
+
+  const std::size_t offset = colors_.size();
+  colors_.resize(offset + size);
+  offsets_.push_back(colors_.size());
+  return colors_.data() + offset;
+}
+
+void ColorSequenceBatch::Reserve(const std::size_t sequences, const std::size_t colors) {
+  offsets_.reserve(sequences + 1);
+  colors_.reserve(colors);
+}
+
+void ColorSequenceBatch::Clear() noexcept {
+  colors_.clear();
+
+  // Shrinking never allocates, a moved-from batch is left without offsets.
+  if (!offsets_.empty()) {
+    offsets_.resize(1);
+  }
+}
+
+void CountingSort(ColorSequenceBatch& batch, const ColorOrder& color_order) noexcept {
+  for (std::size_t i = 0; i < batch.Size(); ++i) {
+    Color* first = batch.Begin(i);
+    Color* last = batch.End(i);
+    const auto histogram = batch.SequenceSize(i) < detail::kSimdCountThreshold ? CountColorsScalar(first, last)
+                                                                                : CountColorsSimd(first, last);
+    FillSortedColors(histogram, color_order, first);
+  }
+}
+
+}  // namespace proud_color_sorter
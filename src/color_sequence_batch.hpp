@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <color.hpp>
+#include <counting_sort.hpp>
+
+namespace proud_color_sorter {
+
+/// Batch of color sequences stored back to back in a single contiguous buffer.
+///
+/// Sequence \c i occupies colors `[offsets[i], offsets[i + 1])` of the buffer. All memory is taken from a
+/// \c std::pmr::memory_resource, so a batch may live in an arena, e. g. \c std::pmr::monotonic_buffer_resource, and be
+/// released at once together with it.
+///
+/// A moved-from batch is empty and may be reused. It has no offsets at all until the next \ref Add, so moves never
+/// allocate.
+class ColorSequenceBatch {
+ public:
+  using allocator_type = std::pmr::polymorphic_allocator<Color>;  // NOLINT
+
+  /// Creates an empty batch, which allocates memory from \a resource.
+  explicit ColorSequenceBatch(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /// Creates an empty batch, which allocates memory from the resource of \a allocator. Lets containers, like
+  /// \c std::pmr::vector, pass their resource down to batches they hold.
+  explicit ColorSequenceBatch(const allocator_type& allocator);
+
+  ColorSequenceBatch(const ColorSequenceBatch& other) = default;
+
+  /// Copies \a other to memory taken from the resource of \a allocator.
+  ColorSequenceBatch(const ColorSequenceBatch& other, const allocator_type& allocator);
+
+  ColorSequenceBatch(ColorSequenceBatch&& other) noexcept = default;
+
+  /// Moves \a other to memory taken from the resource of \a allocator. Memory is copied if resources differ, \a other
+  /// is left empty anyway.
+  ColorSequenceBatch(ColorSequenceBatch&& other, const allocator_type& allocator);
+
+  ColorSequenceBatch& operator=(const ColorSequenceBatch& other) = default;
+
+  /// Moves \a other to this batch, memory is copied if resources differ. Either way \a other is left empty.
+  ColorSequenceBatch& operator=(ColorSequenceBatch&& other);
+
+  ~ColorSequenceBatch() = default;
+
+  /// Returns the number of sequences in the batch.
+  [[nodiscard]] std::size_t Size() const noexcept { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+  /// Returns \c true if the batch has no sequences.
+  [[nodiscard]] bool IsEmpty() const noexcept { return Size() == 0; }
+
+  /// Returns the total number of colors of all sequences.
+  [[nodiscard]] std::size_t ColorCount() const noexcept { return colors_.size(); }
+
+  /// Returns the number of colors in sequence at \a index.
+  [[nodiscard]] std::size_t SequenceSize(std::size_t index) const noexcept {
+    return offsets_[index + 1] - offsets_[index];
+  }
+
+  /// Returns pointer to the first color of sequence at \a index.
+  [[nodiscard]] Color* Begin(std::size_t index) noexcept { return colors_.data() + offsets_[index]; }
+
+  [[nodiscard]] const Color* Begin(std::size_t index) const noexcept { return colors_.data() + offsets_[index]; }
+
+  /// Returns pointer to the color after the last one of sequence at \a index.
+  [[nodiscard]] Color* End(std::size_t index) noexcept { return colors_.data() + offsets_[index + 1]; }
+
+  [[nodiscard]] const Color* End(std::size_t index) const noexcept { return colors_.data() + offsets_[index + 1]; }
+
+  /// Appends a sequence copied from range [\a first, \a last).
+  void Add(const Color* first, const Color* last);
+
+  /// Appends a sequence of \a size colors and returns pointer to its first color, so the caller can fill it in.
+  /// The pointer is invalidated by the next \ref Add.
+  Color* Add(std::size_t size);
+
+  /// Reserves memory for \a sequences sequences having \a colors colors in total.
+  void Reserve(std::size_t sequences, std::size_t colors);
+
+  /// Removes all sequences, keeping the allocated memory.
+  void Clear() noexcept;
+
+  /// Returns colors of all sequences.
+  [[nodiscard]] const std::pmr::vector<Color>& Colors() const noexcept { return colors_; }
+
+  /// Returns `Size() + 1` offsets of sequences in \ref Colors, the last one is equal to \ref ColorCount. A moved-from
+  /// batch has no offsets.
+  [[nodiscard]] const std::pmr::vector<std::size_t>& Offsets() const noexcept { return offsets_; }
+
+  /// Returns memory resource the batch allocates from.
+  [[nodiscard]] std::pmr::memory_resource* GetResource() const noexcept { return colors_.get_allocator().resource(); }
+
+ private:
+  std::pmr::vector<Color> colors_;
+  std::pmr::vector<std::size_t> offsets_;
+};
+
+/// Sorts every sequence of \a batch in place using \a color_order.
+///
+/// Sequences are processed in storage order, so the whole batch is read and written linearly.
+void CountingSort(ColorSequenceBatch& batch, const ColorOrder& color_order) noexcept;
+
+}  // namespace proud_color_sorter
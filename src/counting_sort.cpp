@@ -1,35 +1,144 @@
 #include <counting_sort.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <color_histogram.hpp>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define PROUD_COLOR_SORTER_STREAMING_STORES
+#include <emmintrin.h>
+#endif
 
 namespace proud_color_sorter {
 
 namespace detail {
 
-std::array<std::size_t, kColorSize> CountColors(const std::vector<Color>& colors, const ColorOrder& order) {
-  std::array<std::size_t, kColorSize> color_count;
+void CopyStreaming(void* out, const void* in, std::size_t size) noexcept {
+#ifdef PROUD_COLOR_SORTER_STREAMING_STORES
+  constexpr std::size_t kVectorSize = sizeof(__m128i);
+
+  auto* dst = static_cast<unsigned char*>(out);
+  const auto* src = static_cast<const unsigned char*>(in);
 
-  for (std::size_t i = 0; i < color_count.size(); ++i) {
-    color_count[i] = 0;
+  // Streaming stores need aligned destination, so the unaligned head is copied as usual.
+  const std::size_t head_size =
+      std::min(size, (kVectorSize - reinterpret_cast<std::uintptr_t>(dst) % kVectorSize) % kVectorSize);
+  std::memcpy(dst, src, head_size);
+  dst += head_size;
+  src += head_size;
+  size -= head_size;
+
+  for (; size >= kVectorSize; size -= kVectorSize, dst += kVectorSize, src += kVectorSize) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
   }
 
-  for (const Color color : colors) {
-    ++color_count[order.GetRank(color)];
+  std::memcpy(dst, src, size);
+#else
+  std::memcpy(out, in, size);
+#endif
+}
+
+void FenceStreamingStores() noexcept {
+#ifdef PROUD_COLOR_SORTER_STREAMING_STORES
+  _mm_sfence();
+#endif
+}
+
+std::array<std::size_t, kColorSize> CountColors(const std::vector<Color>& colors, const ColorOrder& order) {
+  const auto histogram = CountColorsSimd(colors.data(), colors.data() + colors.size());
+  std::array<std::size_t, kColorSize> color_count{};
+
+  for (std::size_t i = 0; i < histogram.size(); ++i) {
+    color_count[order.GetRank(static_cast<Color>(i))] = histogram[i];
   }
 
   return color_count;
 }
 
-void AddColorTo(std::vector<Color>& colors, std::size_t color_count, const Color color) {
-  while (color_count > 0) {
-    colors.emplace_back(color);
-    --color_count;
+void AddColorTo(std::vector<Color>& colors, const std::size_t color_count, const Color color) {
+  // Appends the whole run at once: a single capacity check and a `memset` for byte-sized colors.
+  colors.insert(colors.end(), color_count, color);
+}
+
+/// Kernels of the order `First Second Third`. Colors are template arguments, so comparisons with them and run
+/// boundaries are compiled to constants. Counting is shared with \ref CountingSort, since it doesn't depend on the
+/// order.
+template <Color First, Color Second, Color Third>
+struct OrderKernels {
+  static_assert(First != Second && First != Third && Second != Third, "Colors of an order must be different");
+
+  static void CountingSort(const Color* first, const Color* last, Color* out) noexcept {
+    const ColorHistogram histogram = CountColorsSimd(first, last);
+    out = FillRun<First>(histogram, out);
+    out = FillRun<Second>(histogram, out);
+    FillRun<Third>(histogram, out);
   }
+
+  static void SortInPlace(Color* first, Color* last) noexcept {
+    Color* low = first;
+    Color* mid = first;
+    Color* high = last;
+
+    while (mid < high) {
+      const Color color = *mid;
+
+      if (color == First) {
+        std::swap(*low++, *mid++);
+      } else if (color == Second) {
+        ++mid;
+      } else {
+        std::swap(*mid, *--high);
+      }
+    }
+  }
+
+  template <Color RunColor>
+  static Color* FillRun(const ColorHistogram& histogram, Color* out) noexcept {
+    constexpr auto kColorIndex = static_cast<std::size_t>(RunColor);
+
+    if (histogram[kColorIndex] != 0) {
+      std::memset(out, static_cast<int>(RunColor), histogram[kColorIndex]);
+    }
+
+    return out + histogram[kColorIndex];
+  }
+};
+
+template <std::size_t OrderIndex>
+constexpr ColorSortKernels MakeColorSortKernels() noexcept {
+  constexpr const ColorOrder& kOrder = kAllColorOrders[OrderIndex];
+  using Kernels = OrderKernels<kOrder.GetElement(0), kOrder.GetElement(1), kOrder.GetElement(2)>;
+
+  return ColorSortKernels{&Kernels::CountingSort, &Kernels::SortInPlace};
 }
 
+template <std::size_t... OrderIndices>
+constexpr std::array<ColorSortKernels, kColorOrderCount> MakeAllColorSortKernels(
+    std::index_sequence<OrderIndices...> /*indices*/) noexcept {
+  return {MakeColorSortKernels<OrderIndices>()...};
+}
+
+/// Kernels of every order, indexed like \ref kAllColorOrders.
+constexpr auto kAllColorSortKernels = MakeAllColorSortKernels(std::make_index_sequence<kColorOrderCount>{});
+
 }  // namespace detail
 
+std::size_t GetColorOrderIndex(const ColorOrder& color_order) {
+  for (std::size_t i = 0; i < kAllColorOrders.size(); ++i) {
+    // All ranks are compared, so an order, which isn't a permutation of colors, matches none.
+    if (std::equal(color_order.begin(), color_order.end(), kAllColorOrders[i].begin())) {
+      return i;
+    }
+  }
+
+  throw std::invalid_argument{"Color order must rank every color exactly once"};
+}
+
 std::vector<Color> CountingSort(const std::vector<Color>& colors, const ColorOrder& color_order) {
   auto color_count = detail::CountColors(colors, color_order);
 
@@ -43,4 +152,85 @@ std::vector<Color> CountingSort(const std::vector<Color>& colors, const ColorOrd
   return sorted_colors;
 }
 
+void CountingSort(const Color* first, const Color* last, const ColorOrder& color_order, Color* out) noexcept {
+  FillSortedColors(CountColorsSimd(first, last), color_order, out);
+}
+
+void CountingSortMultiOrder(const Color* first, const Color* last, const ColorOrder* orders_first,
+                            const ColorOrder* orders_last, Color* const* outs) noexcept {
+  const ColorHistogram histogram = CountColorsSimd(first, last);
+
+  for (; orders_first != orders_last; ++orders_first, ++outs) {
+    FillSortedColors(histogram, *orders_first, *outs);
+  }
+}
+
+std::vector<std::vector<Color>> CountingSortMultiOrder(const std::vector<Color>& colors,
+                                                       const std::vector<ColorOrder>& color_orders) {
+  const ColorHistogram histogram = CountColorsSimd(colors.data(), colors.data() + colors.size());
+  std::vector<std::vector<Color>> sorted_colors(color_orders.size());
+
+  // Outputs are filled into reserved memory, so every color is written once instead of being zeroed first.
+  for (std::size_t i = 0; i < color_orders.size(); ++i) {
+    sorted_colors[i].reserve(colors.size());
+
+    for (const Color color : color_orders[i]) {
+      detail::AddColorTo(sorted_colors[i], histogram[static_cast<std::size_t>(color)], color);
+    }
+  }
+
+  return sorted_colors;
+}
+
+Color* FillSortedColors(const ColorHistogram& histogram, const ColorOrder& color_order, Color* out) noexcept {
+  for (const Color color : color_order) {
+    const std::size_t color_count = histogram[static_cast<std::size_t>(color)];
+
+    // `memset` requires a valid pointer even for zero bytes, while output of an empty range may be null.
+    if (color_count != 0) {
+      std::memset(out, static_cast<int>(color), color_count);
+    }
+
+    out += color_count;
+  }
+
+  return out;
+}
+
+void SortInPlace(Color* first, Color* last, const ColorOrder& color_order) noexcept {
+  static_assert(kColorSize == 3, "Three-way partition requires exactly three colors");
+
+  // Invariant: [first, low) has rank 0, [low, mid) has rank 1, [high, last) has rank 2, [mid, high) is not seen yet.
+  Color* low = first;
+  Color* mid = first;
+  Color* high = last;
+
+  while (mid < high) {
+    switch (color_order.GetRank(*mid)) {
+      case 0:
+        std::swap(*low, *mid);
+        ++low;
+        ++mid;
+        break;
+
+      case 1:
+        ++mid;
+        break;
+
+      default:
+        --high;
+        std::swap(*mid, *high);
+        break;
+    }
+  }
+}
+
+void SortInPlace(std::vector<Color>& colors, const ColorOrder& color_order) noexcept {
+  SortInPlace(colors.data(), colors.data() + colors.size(), color_order);
+}
+
+const ColorSortKernels& GetColorSortKernels(const ColorOrder& color_order) {
+  return detail::kAllColorSortKernels[GetColorOrderIndex(color_order)];
+}
+
 }  // namespace proud_color_sorter
\ No newline at end of file
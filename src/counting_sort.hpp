@@ -1,14 +1,58 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
 #include <vector>
 
 #include <color.hpp>
+#include <color_histogram.hpp>
 #include <order.hpp>
 
 namespace proud_color_sorter {
 
 using ColorOrder = Order<Color, kColorSize>;
 
+/// Number of different orders of colors, i. e. `kColorSize!`.
+constexpr std::size_t kColorOrderCount = 6;
+
+namespace detail {
+
+constexpr std::array<ColorOrder, kColorOrderCount> MakeAllColorOrders() noexcept {
+  static_assert(kColorSize == 3, "Orders are enumerated as permutations of three colors");
+
+  std::array<ColorOrder, kColorOrderCount> orders{};
+  std::size_t index = 0;
+
+  for (std::size_t first = 0; first < kColorSize; ++first) {
+    for (std::size_t second = 0; second < kColorSize; ++second) {
+      if (second == first) {
+        continue;
+      }
+
+      orders[index].Set(static_cast<Color>(first), 0);
+      orders[index].Set(static_cast<Color>(second), 1);
+      orders[index].Set(static_cast<Color>(kColorSize - first - second), 2);
+      ++index;
+    }
+  }
+
+  return orders;
+}
+
+}  // namespace detail
+
+/// Every order of colors, sorted lexicographically by the underlying values of colors from the first rank to the
+/// last one, i. e. `R G B` comes first and `B G R` comes last.
+constexpr std::array<ColorOrder, kColorOrderCount> kAllColorOrders = detail::MakeAllColorOrders();
+
+/// Returns index of \a color_order in \ref kAllColorOrders.
+/// Throws \c std::invalid_argument if \a color_order doesn't rank every color exactly once.
+std::size_t GetColorOrderIndex(const ColorOrder& color_order);
+
 /// Sorts \a colors using \a color_order.
 ///
 /// Creates a new vector of sorted colors.
@@ -23,6 +67,159 @@ using ColorOrder = Order<Color, kColorSize>;
 ///
 /// });
 /// ```
+/// It takes O(n log n) comparisons though. Records with a color field are sorted in O(n) by \ref CountingSortBy.
 std::vector<Color> CountingSort(const std::vector<Color>& colors, const ColorOrder& color_order);
 
+/// Sorts colors in range [\a first, \a last) using \a color_order and writes them to \a out.
+///
+/// \a out must have room for `last - first` colors, it may be equal to \a first to sort in place.
+void CountingSort(const Color* first, const Color* last, const ColorOrder& color_order, Color* out) noexcept;
+
+/// Sorts colors in range [\a first, \a last) using every order from range [\a orders_first, \a orders_last) and
+/// writes colors sorted by `orders_first[i]` to `outs[i]`.
+///
+/// The input is counted only once, every extra order costs just writing its output.
+/// Every output must have room for `last - first` colors, the first one may be equal to \a first.
+void CountingSortMultiOrder(const Color* first, const Color* last, const ColorOrder* orders_first,
+                            const ColorOrder* orders_last, Color* const* outs) noexcept;
+
+/// Sorts \a colors using every order of \a color_orders, counting them once.
+///
+/// Returns a vector of sorted colors per order.
+std::vector<std::vector<Color>> CountingSortMultiOrder(const std::vector<Color>& colors,
+                                                       const std::vector<ColorOrder>& color_orders);
+
+/// Writes colors counted in \a histogram to \a out as runs following \a color_order.
+///
+/// Each run is written with a single `memset`, so the output is emitted at memory bandwidth.
+/// Returns pointer to the element after the last written one.
+Color* FillSortedColors(const ColorHistogram& histogram, const ColorOrder& color_order, Color* out) noexcept;
+
+/// Stably sorts records in range [\a first, \a last) by their colors using \a color_order and writes them to \a out.
+///
+/// \a key is invoked with a record and returns its \ref Color, e. g. a pointer to a data member. Records are counted
+/// in one pass and copied to their places in another, so the sort is O(n) and calls \a key twice per record.
+/// Large trivially copyable records, which don't fit into cache all together, are staged in a small buffer per color
+/// and copied out by whole buffers with non-temporal stores.
+/// \a out must have room for `last - first` records and must not overlap the input.
+template <typename Record, typename Projection>
+void CountingSortBy(const Record* first, const Record* last, const ColorOrder& color_order, Projection key,
+                    Record* out);
+
+/// Sorts colors in range [\a first, \a last) in place using \a color_order.
+///
+/// Single pass three-way partition (Dutch national flag), doesn't allocate memory.
+void SortInPlace(Color* first, Color* last, const ColorOrder& color_order) noexcept;
+
+/// Sorts \a colors in place using \a color_order.
+void SortInPlace(std::vector<Color>& colors, const ColorOrder& color_order) noexcept;
+
+/// Sorting functions compiled for a single order, which is a constant inside of them instead of \ref ColorOrder
+/// lookups.
+struct ColorSortKernels {
+  /// Same as \ref CountingSort of range [\a first, \a last) into \a out. Only writing of runs is specialized: counting
+  /// doesn't depend on the order, so it's done by \ref CountColorsSimd like in \ref CountingSort.
+  void (*counting_sort)(const Color* first, const Color* last, Color* out) noexcept;
+
+  /// Same as \ref SortInPlace of range [\a first, \a last).
+  void (*sort_in_place)(Color* first, Color* last) noexcept;
+};
+
+/// Returns kernels compiled for \a color_order.
+///
+/// Selecting them takes a lookup in \ref kAllColorOrders, so it's meant to be done once per order, not per sequence.
+/// Throws \c std::invalid_argument if \a color_order doesn't rank every color exactly once.
+const ColorSortKernels& GetColorSortKernels(const ColorOrder& color_order);
+
+namespace detail {
+
+/// Records at least this large are scattered through per-color staging buffers by \ref CountingSortBy...
+constexpr std::size_t kStagedRecordMinSize = 32;
+
+/// ...if the sorted records take at least this many bytes, i. e. don't fit into cache anyway.
+constexpr std::size_t kStagedOutputMinSize = std::size_t{64} << 20;
+
+/// Size of the staging buffer of each color.
+constexpr std::size_t kStagingBufferSize = 4096;
+
+/// Copies \a size bytes from \a in to \a out with non-temporal stores if the CPU has them. Such stores go to memory
+/// in whole cache lines, bypassing the cache, so the destination isn't read before being overwritten.
+/// \ref FenceStreamingStores must be called before the copied bytes are read.
+void CopyStreaming(void* out, const void* in, std::size_t size) noexcept;
+
+/// Makes bytes written by \ref CopyStreaming visible to other reads and threads.
+void FenceStreamingStores() noexcept;
+
+template <typename Record>
+constexpr bool kIsStagedRecord = std::is_trivially_copyable_v<Record> && sizeof(Record) >= kStagedRecordMinSize;
+
+/// Copies every record to the next free place of its color, \a next holds those places by color.
+template <typename Record, typename Projection>
+void ScatterRecords(const Record* first, const Record* last, Projection& key, std::array<Record*, kColorSize>& next) {
+  for (; first != last; ++first) {
+    *next[static_cast<std::size_t>(std::invoke(key, *first))]++ = *first;
+  }
+}
+
+/// Same as \ref ScatterRecords, but gathers records of every color in a staging buffer first, so the output is
+/// written by large streaming copies instead of a record at a time to three interleaved places.
+template <typename Record, typename Projection>
+void ScatterRecordsStaged(const Record* first, const Record* last, Projection& key,
+                          std::array<Record*, kColorSize>& next) {
+  constexpr std::size_t kStagedRecords = std::max<std::size_t>(kStagingBufferSize / sizeof(Record), 1);
+
+  // Raw bytes, so records don't have to be default constructible.
+  std::array<std::array<unsigned char, sizeof(Record) * kStagedRecords>, kColorSize> staging;
+  std::array<std::size_t, kColorSize> staged{};
+
+  for (; first != last; ++first) {
+    const auto color = static_cast<std::size_t>(std::invoke(key, *first));
+    std::memcpy(staging[color].data() + sizeof(Record) * staged[color], first, sizeof(Record));
+
+    if (++staged[color] == kStagedRecords) {
+      CopyStreaming(next[color], staging[color].data(), sizeof(Record) * kStagedRecords);
+      next[color] += kStagedRecords;
+      staged[color] = 0;
+    }
+  }
+
+  for (std::size_t color = 0; color < kColorSize; ++color) {
+    if (staged[color] > 0) {
+      std::memcpy(next[color], staging[color].data(), sizeof(Record) * staged[color]);
+      next[color] += staged[color];
+    }
+  }
+
+  FenceStreamingStores();
+}
+
+}  // namespace detail
+
+template <typename Record, typename Projection>
+void CountingSortBy(const Record* first, const Record* last, const ColorOrder& color_order, Projection key,
+                    Record* out) {
+  ColorHistogram histogram{};
+
+  for (const Record* record = first; record != last; ++record) {
+    ++histogram[static_cast<std::size_t>(std::invoke(key, *record))];
+  }
+
+  // Place of the first record of every color, indexed by the color's underlying value.
+  std::array<Record*, kColorSize> next{};
+
+  for (const Color color : color_order) {
+    next[static_cast<std::size_t>(color)] = out;
+    out += histogram[static_cast<std::size_t>(color)];
+  }
+
+  if constexpr (detail::kIsStagedRecord<Record>) {
+    if (static_cast<std::size_t>(last - first) * sizeof(Record) >= detail::kStagedOutputMinSize) {
+      detail::ScatterRecordsStaged(first, last, key, next);
+      return;
+    }
+  }
+
+  detail::ScatterRecords(first, last, key, next);
+}
+
 }  // namespace proud_color_sorter
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace proud_color_sorter {
+
+/// Describes enums whose underlying values form a dense range `[0, kSize)`.
+///
+/// Specialize it for such an enum and set \c kSize to the number of its values: containers like \ref Order then index
+/// flat tables by the underlying value instead of hashing. \c kSize equal to \c 0 means the enum is not dense.
+template <typename T>
+struct DenseEnumTraits {
+  static constexpr std::size_t kSize = 0;
+};
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace proud_color_sorter {
+
+/// Multi-producer/Multi-consumer (MPMC) bounded blocking queue.
+///
+/// Same API as \ref MPMCUnboundedBlockingQueue, but elements are kept in a ring of slots allocated once on
+/// construction, so neither putting nor taking allocates. \ref Put and \ref PutBatch block producers while the queue
+/// is full.
+template <typename T>
+class MPMCBoundedBlockingQueue {
+ public:
+  /// Creates a queue, which holds at most \a capacity elements. \a capacity must be positive.
+  explicit MPMCBoundedBlockingQueue(std::size_t capacity);
+
+  MPMCBoundedBlockingQueue(const MPMCBoundedBlockingQueue& other) = delete;
+
+  MPMCBoundedBlockingQueue& operator=(const MPMCBoundedBlockingQueue& other) = delete;
+
+  ~MPMCBoundedBlockingQueue() = default;
+
+  /// Put an \a element to the queue if it's not closed and returns \c true, if the queue is closed does nothing and
+  /// returns \c false. Blocks caller while the queue is full.
+  bool Put(T element);
+
+  /// Returns element from the queue head if it's not closed and not empty.
+  /// Blocks caller if the queue is empty and not closed until it's filled.
+  /// In case if the queue is closed and empty, returns \c std::optional containing \c std::nullopt
+  std::optional<T> Take();
+
+  /// Puts elements from range [\a first, \a last) to the queue, as many at once as there are free slots. Elements are
+  /// moved from. Blocks caller while the queue is full. Returns \c false if the queue is closed before all elements
+  /// are put, the rest of them are left untouched.
+  template <typename InputIt>
+  bool PutBatch(InputIt first, InputIt last);
+
+  /// Moves up to \a max_count elements from the queue head to \a out under a single lock acquisition.
+  /// Blocks caller if the queue is empty and not closed until it's filled.
+  /// Returns the number of taken elements, \c 0 means the queue is closed and empty.
+  /// If \a max_count is \c 0, returns \c 0 immediately without blocking.
+  template <typename OutputIt>
+  std::size_t TakeBatch(OutputIt out, std::size_t max_count);
+
+  /// Closes the queue for new \ref Put calls, blocked producers are woken up.
+  void Close();
+
+  /// Closes the queue. Drains pending elements from the queue.
+  void Cancel();
+
+  /// Returns the maximum number of elements in the queue.
+  [[nodiscard]] std::size_t Capacity() const noexcept { return slots_.size(); }
+
+ private:
+  void CloseImpl(bool need_drain);
+
+  /// Moves the element out of the head slot. Must be called under \ref lock_ on a non-empty queue.
+  T PopFront();
+
+ private:
+  std::vector<std::optional<T>> slots_;
+  std::size_t head_{0};
+  std::size_t size_{0};
+  std::mutex lock_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  bool is_closed_{false};
+};
+
+template <typename T>
+MPMCBoundedBlockingQueue<T>::MPMCBoundedBlockingQueue(const std::size_t capacity) : slots_(capacity) {
+  assert(capacity > 0);
+}
+
+template <typename T>
+bool MPMCBoundedBlockingQueue<T>::Put(T element) {
+  {
+    std::unique_lock lock{lock_};
+
+    while (size_ == slots_.size() && !is_closed_) {
+      not_full_.wait(lock);
+    }
+
+    if (is_closed_) {
+      return false;
+    }
+
+    slots_[(head_ + size_) % slots_.size()].emplace(std::move(element));
+    ++size_;
+  }
+
+  not_empty_.notify_one();
+
+  return true;
+}
+
+template <typename T>
+std::optional<T> MPMCBoundedBlockingQueue<T>::Take() {
+  std::optional<T> element = std::nullopt;
+
+  {
+    std::unique_lock lock{lock_};
+
+    while (size_ == 0 && !is_closed_) {
+      not_empty_.wait(lock);
+    }
+
+    if (size_ == 0) {
+      return element;
+    }
+
+    element.emplace(PopFront());
+  }
+
+  not_full_.notify_one();
+
+  return element;
+}
+
+template <typename T>
+template <typename InputIt>
+bool MPMCBoundedBlockingQueue<T>::PutBatch(InputIt first, InputIt last) {
+  std::unique_lock lock{lock_};
+
+  while (first != last) {
+    while (size_ == slots_.size() && !is_closed_) {
+      not_full_.wait(lock);
+    }
+
+    if (is_closed_) {
+      return false;
+    }
+
+    for (; first != last && size_ < slots_.size(); ++first) {
+      slots_[(head_ + size_) % slots_.size()].emplace(std::move(*first));
+      ++size_;
+    }
+
+    not_empty_.notify_all();
+  }
+
+  return !is_closed_;
+}
+
+template <typename T>
+template <typename OutputIt>
+std::size_t MPMCBoundedBlockingQueue<T>::TakeBatch(OutputIt out, const std::size_t max_count) {
+  if (max_count == 0) {
+    return 0;
+  }
+
+  std::size_t taken = 0;
+
+  {
+    std::unique_lock lock{lock_};
+
+    while (size_ == 0 && !is_closed_) {
+      not_empty_.wait(lock);
+    }
+
+    for (; size_ > 0 && taken < max_count; ++taken) {
+      *out = PopFront();
+      ++out;
+    }
+  }
+
+  if (taken > 0) {
+    not_full_.notify_all();
+  }
+
+  return taken;
+}
+
+template <typename T>
+void MPMCBoundedBlockingQueue<T>::Close() {
+  CloseImpl(/*need_drain=*/false);
+}
+
+template <typename T>
+void MPMCBoundedBlockingQueue<T>::Cancel() {
+  CloseImpl(/*need_drain=*/true);
+}
+
+template <typename T>
+void MPMCBoundedBlockingQueue<T>::CloseImpl(const bool need_drain) {
+  std::lock_guard lock{lock_};
+  is_closed_ = true;
+
+  if (need_drain) {
+    while (size_ > 0) {
+      PopFront();
+    }
+  }
+
+  not_empty_.notify_all();
+  not_full_.notify_all();
+}
+
+template <typename T>
+T MPMCBoundedBlockingQueue<T>::PopFront() {
+  auto& slot = slots_[head_];
+  T element = std::move(*slot);
+  slot.reset();
+  head_ = (head_ + 1) % slots_.size();
+  --size_;
+  return element;
+}
+
+}  // namespace proud_color_sorter
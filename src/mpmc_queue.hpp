@@ -0,0 +1,13 @@
+#pragma once
+
+#include <mpsc_queue.hpp>
+
+namespace proud_color_sorter {
+
+/// Multi-producer/Multi-consumer (MPMC) unbounded blocking queue.
+///
+/// Same API as \ref MPSCUnboundedBlockingQueue, but any number of threads may take elements concurrently.
+template <typename T>
+using MPMCUnboundedBlockingQueue = detail::UnboundedBlockingQueue<T, /*IsMultiConsumer=*/true>;
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace proud_color_sorter {
+
+namespace detail {
+
+/// Parks threads until some condition changes, futex style.
+///
+/// Waiter announces itself via \ref PrepareToPark, re-checks its condition and either parks via \ref Park or
+/// withdraws via \ref CancelPark. \ref UnparkAll touches the mutex only while some waiter is announced, so
+/// notifications are almost free while nobody is parked.
+class ParkingLot {
+ public:
+  [[nodiscard]] std::uint32_t PrepareToPark() noexcept {
+    waiters_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return epoch_.load();
+  }
+
+  /// Withdraws the announcement made by \ref PrepareToPark, when the condition is met on the re-check.
+  void CancelPark() noexcept { waiters_.fetch_sub(1); }
+
+  void Park(const std::uint32_t epoch) {
+    {
+      std::unique_lock lock{mutex_};
+
+      while (epoch_.load() == epoch) {
+        epoch_changed_.wait(lock);
+      }
+    }
+
+    waiters_.fetch_sub(1);
+  }
+
+  /// Wakes up all parked threads. Must be called after the condition they wait for is changed.
+  void UnparkAll() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Waiter, which announced itself later, re-checks the condition after it's changed, so it won't park.
+    if (waiters_.load() == 0) {
+      return;
+    }
+
+    epoch_.fetch_add(1);
+    std::lock_guard lock{mutex_};
+    epoch_changed_.notify_all();
+  }
+
+ private:
+  std::atomic<std::uint32_t> epoch_{0};
+  std::atomic<std::uint32_t> waiters_{0};
+  std::mutex mutex_;
+  std::condition_variable epoch_changed_;
+};
+
+}  // namespace detail
+
+/// Multi-producer/Single-consumer (MPSC) bounded lock-free queue.
+///
+/// Ring buffer of sequence-numbered slots (D. Vyukov's bounded queue). \ref Put and \ref Take are lock-free while the
+/// queue is neither full nor empty, threads are parked only to wait for a free slot or an element.
+/// Unlike \ref MPSCUnboundedBlockingQueue, \ref Put blocks producers while the queue is full.
+template <typename T>
+class MPSCBoundedLockFreeQueue {
+ public:
+  /// Creates a queue, which holds at least \a capacity elements. Capacity is rounded up to a power of two.
+  explicit MPSCBoundedLockFreeQueue(std::size_t capacity);
+
+  MPSCBoundedLockFreeQueue(const MPSCBoundedLockFreeQueue& other) = delete;
+
+  MPSCBoundedLockFreeQueue& operator=(const MPSCBoundedLockFreeQueue& other) = delete;
+
+  ~MPSCBoundedLockFreeQueue() = default;
+
+  /// Put an \a element to the queue if it's not closed and returns \c true, if the queue is closed does nothing and
+  /// returns \c false. Blocks caller while the queue is full.
+  bool Put(T element);
+
+  /// Put an \a element to the queue if it's neither closed nor full and returns \c true, returns \c false otherwise.
+  /// \a element is moved from only on success.
+  bool TryPut(T&& element);
+
+  /// Returns element from the queue head if it's not closed and not empty.
+  /// Blocks caller if the queue is empty and not closed until it's filled.
+  /// In case if the queue is closed and empty, or cancelled, returns \c std::optional containing \c std::nullopt
+  std::optional<T> Take();
+
+  /// Closes the queue for new \ref Put calls.
+  void Close();
+
+  /// Closes the queue. Pending elements are dropped by the consumer on the next \ref Take call, since only the
+  /// consumer may pop them.
+  void Cancel();
+
+  /// Returns the maximum number of elements in the queue.
+  [[nodiscard]] std::size_t Capacity() const noexcept { return mask_ + 1; }
+
+ private:
+  enum class PutStatus { kOk, kFull, kClosed };
+
+  struct Slot {
+    std::atomic<std::size_t> sequence{0};
+    std::optional<T> value;
+  };
+
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  /// Set in \ref tail_ by \ref Close, so no producer can claim a slot afterwards.
+  static constexpr std::size_t kClosedBit = std::size_t{1} << (sizeof(std::size_t) * 8 - 1);
+
+  static std::size_t RoundUpCapacity(std::size_t capacity) noexcept;
+
+  PutStatus TryPutImpl(T& element);
+  PutStatus TryEnqueue(T& element);
+  std::optional<T> TryDequeue();
+  void Drain();
+
+ private:
+  std::unique_ptr<Slot[]> slots_;
+  std::size_t mask_;
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+  alignas(kCacheLineSize) std::size_t head_{0};
+  alignas(kCacheLineSize) std::atomic<bool> is_cancelled_{false};
+
+  detail::ParkingLot not_empty_;
+  detail::ParkingLot not_full_;
+};
+
+template <typename T>
+MPSCBoundedLockFreeQueue<T>::MPSCBoundedLockFreeQueue(const std::size_t capacity)
+    : slots_(std::make_unique<Slot[]>(RoundUpCapacity(capacity))), mask_(RoundUpCapacity(capacity) - 1) {
+  for (std::size_t i = 0; i <= mask_; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+bool MPSCBoundedLockFreeQueue<T>::Put(T element) {
+  while (true) {
+    auto status = TryPutImpl(element);
+
+    if (status != PutStatus::kFull) {
+      return status == PutStatus::kOk;
+    }
+
+    const auto epoch = not_full_.PrepareToPark();
+    status = TryPutImpl(element);
+
+    if (status != PutStatus::kFull) {
+      not_full_.CancelPark();
+      return status == PutStatus::kOk;
+    }
+
+    not_full_.Park(epoch);
+  }
+}
+
+template <typename T>
+bool MPSCBoundedLockFreeQueue<T>::TryPut(T&& element) {
+  return TryPutImpl(element) == PutStatus::kOk;
+}
+
+template <typename T>
+std::optional<T> MPSCBoundedLockFreeQueue<T>::Take() {
+  while (true) {
+    if (is_cancelled_.load()) {
+      Drain();
+      return std::nullopt;
+    }
+
+    if (auto element = TryDequeue(); element.has_value()) {
+      return element;
+    }
+
+    const std::size_t tail = tail_.load();
+
+    if ((tail & kClosedBit) != 0) {
+      if (head_ == (tail & ~kClosedBit)) {
+        return std::nullopt;
+      }
+
+      // A producer claimed a slot before the queue was closed, but hasn't published its element yet.
+      std::this_thread::yield();
+      continue;
+    }
+
+    const auto epoch = not_empty_.PrepareToPark();
+
+    if (auto element = TryDequeue(); element.has_value()) {
+      not_empty_.CancelPark();
+      return element;
+    }
+
+    if ((tail_.load() & kClosedBit) != 0 || is_cancelled_.load()) {
+      not_empty_.CancelPark();
+      continue;
+    }
+
+    not_empty_.Park(epoch);
+  }
+}
+
+template <typename T>
+void MPSCBoundedLockFreeQueue<T>::Close() {
+  tail_.fetch_or(kClosedBit);
+  not_empty_.UnparkAll();
+  not_full_.UnparkAll();
+}
+
+template <typename T>
+void MPSCBoundedLockFreeQueue<T>::Cancel() {
+  is_cancelled_.store(true);
+  Close();
+}
+
+template <typename T>
+std::size_t MPSCBoundedLockFreeQueue<T>::RoundUpCapacity(const std::size_t capacity) noexcept {
+  std::size_t rounded = 2;
+
+  while (rounded < capacity) {
+    rounded *= 2;
+  }
+
+  return rounded;
+}
+
+template <typename T>
+typename MPSCBoundedLockFreeQueue<T>::PutStatus MPSCBoundedLockFreeQueue<T>::TryPutImpl(T& element) {
+  const auto status = TryEnqueue(element);
+
+  if (status == PutStatus::kOk) {
+    not_empty_.UnparkAll();
+  }
+
+  return status;
+}
+
+template <typename T>
+typename MPSCBoundedLockFreeQueue<T>::PutStatus MPSCBoundedLockFreeQueue<T>::TryEnqueue(T& element) {
+  std::size_t position = tail_.load(std::memory_order_relaxed);
+
+  while (true) {
+    if ((position & kClosedBit) != 0) {
+      return PutStatus::kClosed;
+    }
+
+    Slot& slot = slots_[position & mask_];
+    const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+    if (difference == 0) {
+      if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        slot.value.emplace(std::move(element));
+        slot.sequence.store(position + 1, std::memory_order_release);
+        return PutStatus::kOk;
+      }
+    } else if (difference < 0) {
+      return PutStatus::kFull;
+    } else {
+      position = tail_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+template <typename T>
+std::optional<T> MPSCBoundedLockFreeQueue<T>::TryDequeue() {
+  Slot& slot = slots_[head_ & mask_];
+
+  if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+    return std::nullopt;
+  }
+
+  std::optional<T> element{std::move(slot.value)};
+  slot.value.reset();
+  slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+  ++head_;
+
+  not_full_.UnparkAll();
+
+  return element;
+}
+
+template <typename T>
+void MPSCBoundedLockFreeQueue<T>::Drain() {
+  while (TryDequeue().has_value()) {
+  }
+}
+
+}  // namespace proud_color_sorter
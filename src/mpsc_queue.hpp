@@ -1,15 +1,21 @@
 #pragma once
 
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
 #include <optional>
 #include <queue>
 
 namespace proud_color_sorter {
 
-/// Multi-producer/Single-consumer (MPSC) unbounded blocking queue.
-template <typename T>
-class MPSCUnboundedBlockingQueue {
+namespace detail {
+
+/// Unbounded blocking queue, which any number of producers may put elements to.
+///
+/// Only a single consumer may take elements, unless \a IsMultiConsumer is set. In that case batches and closing wake
+/// up every waiting consumer instead of one.
+template <typename T, bool IsMultiConsumer>
+class UnboundedBlockingQueue {
  public:
   /// Put an \a element to the queue if it's not closed and returns \c true, if the queue is closed does nothing and
   /// returns \c false.
@@ -20,6 +26,18 @@ class MPSCUnboundedBlockingQueue {
   /// In case if the queue is closed, returns \c std::optional containing \c std::nullopt
   std::optional<T> Take();
 
+  /// Puts elements from range [\a first, \a last) to the queue under a single lock acquisition and wakes up
+  /// consumers once. Elements are moved from. Returns \c false and puts nothing if the queue is closed.
+  template <typename InputIt>
+  bool PutBatch(InputIt first, InputIt last);
+
+  /// Moves up to \a max_count elements from the queue head to \a out under a single lock acquisition.
+  /// Blocks caller if the queue is empty and not closed until it's filled.
+  /// Returns the number of taken elements, \c 0 means the queue is closed and empty.
+  /// If \a max_count is \c 0, returns \c 0 immediately without blocking.
+  template <typename OutputIt>
+  std::size_t TakeBatch(OutputIt out, std::size_t max_count);
+
   /// Closes the queue for new \ref Put calls.
   void Close();
 
@@ -29,6 +47,9 @@ class MPSCUnboundedBlockingQueue {
  private:
   void CloseImpl(bool need_drain);
 
+  /// Wakes up the consumer, or every waiting one if \a IsMultiConsumer is set.
+  void NotifyConsumers();
+
  private:
   std::queue<T> queue_;
   std::mutex queue_lock_;
@@ -36,8 +57,8 @@ class MPSCUnboundedBlockingQueue {
   bool is_closed_{false};
 };
 
-template <typename T>
-bool MPSCUnboundedBlockingQueue<T>::Put(T element) {
+template <typename T, bool IsMultiConsumer>
+bool UnboundedBlockingQueue<T, IsMultiConsumer>::Put(T element) {
   {
     std::lock_guard lock{queue_lock_};
 
@@ -53,8 +74,8 @@ bool MPSCUnboundedBlockingQueue<T>::Put(T element) {
   return true;
 }
 
-template <typename T>
-std::optional<T> MPSCUnboundedBlockingQueue<T>::Take() {
+template <typename T, bool IsMultiConsumer>
+std::optional<T> UnboundedBlockingQueue<T, IsMultiConsumer>::Take() {
   std::unique_lock lock{queue_lock_};
 
   std::optional<T> element = std::nullopt;
@@ -73,18 +94,67 @@ std::optional<T> MPSCUnboundedBlockingQueue<T>::Take() {
   return element;
 }
 
-template <typename T>
-void MPSCUnboundedBlockingQueue<T>::Close() {
+template <typename T, bool IsMultiConsumer>
+template <typename InputIt>
+bool UnboundedBlockingQueue<T, IsMultiConsumer>::PutBatch(InputIt first, InputIt last) {
+  {
+    std::lock_guard lock{queue_lock_};
+
+    if (is_closed_) {
+      return false;
+    }
+
+    if (first == last) {
+      return true;
+    }
+
+    for (; first != last; ++first) {
+      queue_.emplace(std::move(*first));
+    }
+  }
+
+  NotifyConsumers();
+
+  return true;
+}
+
+template <typename T, bool IsMultiConsumer>
+template <typename OutputIt>
+std::size_t UnboundedBlockingQueue<T, IsMultiConsumer>::TakeBatch(OutputIt out, const std::size_t max_count) {
+  if (max_count == 0) {
+    return 0;
+  }
+
+  std::unique_lock lock{queue_lock_};
+
+  while (queue_.empty() && !is_closed_) {
+    queue_not_empty_.wait(lock);
+  }
+
+  std::size_t taken = 0;
+
+  while (!queue_.empty() && taken < max_count) {
+    *out = std::move(queue_.front());
+    ++out;
+    queue_.pop();
+    ++taken;
+  }
+
+  return taken;
+}
+
+template <typename T, bool IsMultiConsumer>
+void UnboundedBlockingQueue<T, IsMultiConsumer>::Close() {
   CloseImpl(/*need_drain=*/false);
 }
 
-template <typename T>
-void MPSCUnboundedBlockingQueue<T>::Cancel() {
+template <typename T, bool IsMultiConsumer>
+void UnboundedBlockingQueue<T, IsMultiConsumer>::Cancel() {
   CloseImpl(/*need_drain=*/true);
 }
 
-template <typename T>
-void MPSCUnboundedBlockingQueue<T>::CloseImpl(bool need_drain) {
+template <typename T, bool IsMultiConsumer>
+void UnboundedBlockingQueue<T, IsMultiConsumer>::CloseImpl(bool need_drain) {
   std::lock_guard lock{queue_lock_};
   is_closed_ = true;
 
@@ -94,7 +164,22 @@ void MPSCUnboundedBlockingQueue<T>::CloseImpl(bool need_drain) {
     }
   }
 
-  queue_not_empty_.notify_one();
+  NotifyConsumers();
+}
+
+template <typename T, bool IsMultiConsumer>
+void UnboundedBlockingQueue<T, IsMultiConsumer>::NotifyConsumers() {
+  if constexpr (IsMultiConsumer) {
+    queue_not_empty_.notify_all();
+  } else {
+    queue_not_empty_.notify_one();
+  }
 }
 
+}  // namespace detail
+
+/// Multi-producer/Single-consumer (MPSC) unbounded blocking queue.
+template <typename T>
+using MPSCUnboundedBlockingQueue = detail::UnboundedBlockingQueue<T, /*IsMultiConsumer=*/false>;
+
 }  // namespace proud_color_sorter
\ No newline at end of file
@@ -2,15 +2,62 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <unordered_map>
 
+#include <enum_traits.hpp>
+
 namespace proud_color_sorter {
 
+/// Maps elements of type \a T to their ranks using a hash table. Works for any hashable \a T.
+template <typename T, std::size_t SetSize>
+class HashRankStorage {
+ public:
+  void Set(const T& element, const std::size_t rank) { element_to_rank_[element] = rank; }
+
+  [[nodiscard]] std::size_t Get(const T& element) const { return element_to_rank_.at(element); }
+
+ private:
+  std::unordered_map<T, std::size_t> element_to_rank_;
+};
+
+/// Maps elements of a dense enum \a T (see \ref DenseEnumTraits) to their ranks using a flat table indexed by the
+/// underlying value. Usable in `constexpr` contexts.
+template <typename T, std::size_t SetSize>
+class DenseRankStorage {
+ public:
+  static_assert(std::is_enum_v<T>, "DenseRankStorage requires an enum type");
+  static_assert(DenseEnumTraits<T>::kSize > 0, "DenseRankStorage requires DenseEnumTraits specialization");
+  static_assert(SetSize <= static_cast<std::size_t>(std::numeric_limits<std::uint8_t>::max()) + 1,
+                "Ranks must fit into std::uint8_t");
+
+  constexpr void Set(const T element, const std::size_t rank) noexcept {
+    element_to_rank_[ToIndex(element)] = static_cast<std::uint8_t>(rank);
+  }
+
+  [[nodiscard]] constexpr std::size_t Get(const T element) const noexcept { return element_to_rank_[ToIndex(element)]; }
+
+ private:
+  [[nodiscard]] static constexpr std::size_t ToIndex(const T element) noexcept {
+    return static_cast<std::size_t>(element);
+  }
+
+ private:
+  std::array<std::uint8_t, DenseEnumTraits<T>::kSize> element_to_rank_{};
+};
+
+/// Rank storage used by \ref Order by default: a flat table for dense enums, a hash table otherwise.
+template <typename T, std::size_t SetSize>
+using DefaultRankStorage =
+    std::conditional_t<(DenseEnumTraits<T>::kSize > 0), DenseRankStorage<T, SetSize>, HashRankStorage<T, SetSize>>;
+
 /// Stores order of elements of type \a T.
 /// Provides STL-like iterators API to iterate through the order relation.
-template <typename T, std::size_t SetSize>
+template <typename T, std::size_t SetSize, typename RankStorage = DefaultRankStorage<T, SetSize>>
 class Order {
  public:
   /// A mutable iterator.
@@ -32,34 +79,34 @@ class Order {
   ~Order() = default;
 
   /// Sets map between \a element and \a rank.
-  void Set(T element, const std::size_t rank) noexcept;
+  constexpr void Set(T element, const std::size_t rank) noexcept;
 
   /// Returns rank of an \a element
-  [[nodiscard]] std::size_t GetRank(const T& element) const noexcept;
+  [[nodiscard]] constexpr std::size_t GetRank(const T& element) const noexcept;
 
   /// Returns an element, which rank is equal to \a rank
-  T& GetElement(const std::size_t rank) noexcept;
+  constexpr T& GetElement(const std::size_t rank) noexcept;
 
   /// Returns a const reference to the element by \a rank
-  const T& GetElement(const std::size_t rank) const noexcept;
+  constexpr const T& GetElement(const std::size_t rank) const noexcept;
 
   /// Returns \c true if \a lhs rank is equal to \a rhs rank, returns \c false otherwise.
-  [[nodiscard]] bool IsEqual(const T& lhs, const T& rhs) const noexcept;
+  [[nodiscard]] constexpr bool IsEqual(const T& lhs, const T& rhs) const noexcept;
 
   /// Returns \c true if \a lhs is not equal to \a rhs rank, returns \c false otherwise.
-  [[nodiscard]] bool IsNotEqual(const T& lhs, const T& rhs) const noexcept;
+  [[nodiscard]] constexpr bool IsNotEqual(const T& lhs, const T& rhs) const noexcept;
 
   /// Returns \c true if \a lhs rank is less than \a rhs rank, returns \c false otherwise.
-  [[nodiscard]] bool IsLess(const T& lhs, const T& rhs) const noexcept;
+  [[nodiscard]] constexpr bool IsLess(const T& lhs, const T& rhs) const noexcept;
 
   /// Returns \c true if \a lhs rank is less or equal to \a rhs rank, returns \c false otherwise.
-  [[nodiscard]] bool IsLessOrEqual(const T& lhs, const T& rhs) const noexcept;
+  [[nodiscard]] constexpr bool IsLessOrEqual(const T& lhs, const T& rhs) const noexcept;
 
   /// Returns \c true if \a lhs is greater than \a rhs, returns \c false otherwise.
-  [[nodiscard]] bool IsGreater(const T& lhs, const T& rhs) const noexcept;
+  [[nodiscard]] constexpr bool IsGreater(const T& lhs, const T& rhs) const noexcept;
 
   /// Returns \c true if \a lhs is greater or less than \a rhs, returns \c false otherwise.
-  [[nodiscard]] bool IsGreaterOrEqual(const T& lhs, const T& rhs) const noexcept;
+  [[nodiscard]] constexpr bool IsGreaterOrEqual(const T& lhs, const T& rhs) const noexcept;
 
   /// Returns \a Iterator pointing to the beginning of order.
   [[nodiscard]] Iterator begin() { return Iterator{rank_to_element_.data()}; }  // NOLINT
@@ -80,12 +127,12 @@ class Order {
   [[nodiscard]] ConstIterator end() const { return ConstIterator{rank_to_element_.data() + SetSize}; }  // NOLINT
 
  private:
-  std::array<T, SetSize> rank_to_element_;
-  std::unordered_map<T, std::size_t> element_to_rank_;
+  std::array<T, SetSize> rank_to_element_{};
+  RankStorage element_to_rank_;
 };
 
-template <typename T, std::size_t SetSize>
-class Order<T, SetSize>::Iterator {
+template <typename T, std::size_t SetSize, typename RankStorage>
+class Order<T, SetSize, RankStorage>::Iterator {
  public:
   using iterator_category = std::random_access_iterator_tag;  // NOLINT
   using value_type = T;                                       // NOLINT
@@ -177,8 +224,8 @@ class Order<T, SetSize>::Iterator {
   T* rank_to_element_ptr_ = nullptr;
 };
 
-template <typename T, std::size_t SetSize>
-class Order<T, SetSize>::ConstIterator {
+template <typename T, std::size_t SetSize, typename RankStorage>
+class Order<T, SetSize, RankStorage>::ConstIterator {
  public:
   using iterator_category = std::random_access_iterator_tag;  // NOLINT
   using value_type = const T;                                 // NOLINT
@@ -269,54 +316,54 @@ class Order<T, SetSize>::ConstIterator {
   const T* rank_to_element_ptr_ = nullptr;
 };
 
-template <typename T, std::size_t SetSize>
-void Order<T, SetSize>::Set(T element, const std::size_t rank) noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr void Order<T, SetSize, RankStorage>::Set(T element, const std::size_t rank) noexcept {
+  element_to_rank_.Set(element, rank);
   rank_to_element_[rank] = std::move(element);
-  element_to_rank_[element] = rank;
 }
 
-template <typename T, std::size_t SetSize>
-std::size_t Order<T, SetSize>::GetRank(const T& element) const noexcept {
-  return element_to_rank_.at(element);
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr std::size_t Order<T, SetSize, RankStorage>::GetRank(const T& element) const noexcept {
+  return element_to_rank_.Get(element);
 }
 
-template <typename T, std::size_t SetSize>
-T& Order<T, SetSize>::GetElement(const std::size_t rank) noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr T& Order<T, SetSize, RankStorage>::GetElement(const std::size_t rank) noexcept {
   return rank_to_element_[rank];
 }
 
-template <typename T, std::size_t SetSize>
-const T& Order<T, SetSize>::GetElement(const std::size_t rank) const noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr const T& Order<T, SetSize, RankStorage>::GetElement(const std::size_t rank) const noexcept {
   return rank_to_element_[rank];
 }
 
-template <typename T, std::size_t SetSize>
-bool Order<T, SetSize>::IsEqual(const T& lhs, const T& rhs) const noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr bool Order<T, SetSize, RankStorage>::IsEqual(const T& lhs, const T& rhs) const noexcept {
   return GetRank(lhs) == GetRank(rhs);
 }
 
-template <typename T, std::size_t SetSize>
-bool Order<T, SetSize>::IsNotEqual(const T& lhs, const T& rhs) const noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr bool Order<T, SetSize, RankStorage>::IsNotEqual(const T& lhs, const T& rhs) const noexcept {
   return GetRank(lhs) != GetRank(rhs);
 }
 
-template <typename T, std::size_t SetSize>
-bool Order<T, SetSize>::IsLess(const T& lhs, const T& rhs) const noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr bool Order<T, SetSize, RankStorage>::IsLess(const T& lhs, const T& rhs) const noexcept {
   return GetRank(lhs) < GetRank(rhs);
 }
 
-template <typename T, std::size_t SetSize>
-bool Order<T, SetSize>::IsLessOrEqual(const T& lhs, const T& rhs) const noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr bool Order<T, SetSize, RankStorage>::IsLessOrEqual(const T& lhs, const T& rhs) const noexcept {
   return GetRank(lhs) <= GetRank(rhs);
 }
 
-template <typename T, std::size_t SetSize>
-bool Order<T, SetSize>::IsGreater(const T& lhs, const T& rhs) const noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr bool Order<T, SetSize, RankStorage>::IsGreater(const T& lhs, const T& rhs) const noexcept {
   return GetRank(lhs) > GetRank(rhs);
 }
 
-template <typename T, std::size_t SetSize>
-bool Order<T, SetSize>::IsGreaterOrEqual(const T& lhs, const T& rhs) const noexcept {
+template <typename T, std::size_t SetSize, typename RankStorage>
+constexpr bool Order<T, SetSize, RankStorage>::IsGreaterOrEqual(const T& lhs, const T& rhs) const noexcept {
   return GetRank(lhs) >= GetRank(rhs);
 }
 
@@ -0,0 +1,172 @@
+#include <packed_color_sequence.hpp>
+
+#include <algorithm>
+
+namespace proud_color_sorter {
+
+namespace detail {
+
+/// Has the lowest bit of every 2-bit color slot set.
+constexpr std::uint64_t kLowSlotBits = 0x5555555555555555ULL;
+
+constexpr std::uint64_t kColorMask = 0b11;
+
+std::size_t PopCount(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+  word = word - ((word >> 1) & kLowSlotBits);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<std::size_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/// Returns a word with every color slot equal to \a color.
+constexpr std::uint64_t RepeatColor(const Color color) noexcept {
+  return static_cast<std::uint64_t>(color) * kLowSlotBits;
+}
+
+/// Returns a mask covering the lowest \a count color slots of a word.
+constexpr std::uint64_t LowSlotsMask(const std::size_t count) noexcept {
+  if (count >= PackedColorSequence::kColorsPerWord) {
+    return ~std::uint64_t{0};
+  }
+
+  return (std::uint64_t{1} << (count * PackedColorSequence::kBitsPerColor)) - 1;
+}
+
+}  // namespace detail
+
+PackedColorSequence::PackedColorSequence(const Color* first, const Color* last) { Append(first, last); }
+
+Color PackedColorSequence::Get(const std::size_t index) const noexcept {
+  const std::size_t shift = (index % kColorsPerWord) * kBitsPerColor;
+  return static_cast<Color>((words_[index / kColorsPerWord] >> shift) & detail::kColorMask);
+}
+
+void PackedColorSequence::Set(const std::size_t index, const Color color) noexcept {
+  const std::size_t shift = (index % kColorsPerWord) * kBitsPerColor;
+  std::uint64_t& word = words_[index / kColorsPerWord];
+  word &= ~(detail::kColorMask << shift);
+  word |= static_cast<std::uint64_t>(color) << shift;
+}
+
+void PackedColorSequence::PushBack(const Color color) {
+  if (size_ % kColorsPerWord == 0) {
+    words_.push_back(0);
+  }
+
+  ++size_;
+  Set(size_ - 1, color);
+}
+
+void PackedColorSequence::Append(const Color* first, const Color* last) {
+  // Words are pushed one by one, so the vector grows geometrically even under a stream of short appends.
+  const Color* it = first;
+
+  while (it != last && size_ % kColorsPerWord != 0) {
+    PushBack(*it);
+    ++it;
+  }
+
+  while (static_cast<std::size_t>(last - it) >= kColorsPerWord) {
+    std::uint64_t word = 0;
+
+    for (std::size_t i = 0; i < kColorsPerWord; ++i) {
+      word |= static_cast<std::uint64_t>(it[i]) << (i * kBitsPerColor);
+    }
+
+    words_.push_back(word);
+    size_ += kColorsPerWord;
+    it += kColorsPerWord;
+  }
+
+  for (; it != last; ++it) {
+    PushBack(*it);
+  }
+}
+
+void PackedColorSequence::Append(std::size_t count, const Color color) {
+  const std::uint64_t pattern = detail::RepeatColor(color);
+  const std::size_t used_slots = size_ % kColorsPerWord;
+
+  if (used_slots != 0 && count > 0) {
+    const std::size_t slots = std::min(count, kColorsPerWord - used_slots);
+    words_.back() |= (pattern & detail::LowSlotsMask(slots)) << (used_slots * kBitsPerColor);
+    size_ += slots;
+    count -= slots;
+  }
+
+  const std::size_t full_words = count / kColorsPerWord;
+  words_.insert(words_.end(), full_words, pattern);
+  size_ += full_words * kColorsPerWord;
+  count -= full_words * kColorsPerWord;
+
+  if (count > 0) {
+    words_.push_back(pattern & detail::LowSlotsMask(count));
+    size_ += count;
+  }
+}
+
+void PackedColorSequence::Reserve(const std::size_t size) {
+  words_.reserve((size + kColorsPerWord - 1) / kColorsPerWord);
+}
+
+void PackedColorSequence::Clear() noexcept {
+  words_.clear();
+  size_ = 0;
+}
+
+void PackedColorSequence::Unpack(Color* out) const noexcept {
+  std::size_t left = size_;
+
+  for (const std::uint64_t word : words_) {
+    const std::size_t count = std::min(left, kColorsPerWord);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = static_cast<Color>((word >> (i * kBitsPerColor)) & detail::kColorMask);
+    }
+
+    out += count;
+    left -= count;
+  }
+}
+
+ColorHistogram CountColors(const PackedColorSequence& colors) noexcept {
+  std::size_t green_count = 0;
+  std::size_t blue_count = 0;
+
+  // Green is `01` and blue is `10`. Red `00` takes the rest, including zeroed unused slots of the last word.
+  for (const std::uint64_t word : colors.Words()) {
+    const std::uint64_t low_bits = word & detail::kLowSlotBits;
+    const std::uint64_t high_bits = (word >> 1) & detail::kLowSlotBits;
+    green_count += detail::PopCount(low_bits & ~high_bits);
+    blue_count += detail::PopCount(high_bits & ~low_bits);
+  }
+
+  ColorHistogram histogram{};
+  histogram[static_cast<std::size_t>(Color::kRed)] = colors.Size() - green_count - blue_count;
+  histogram[static_cast<std::size_t>(Color::kGreen)] = green_count;
+  histogram[static_cast<std::size_t>(Color::kBlue)] = blue_count;
+  return histogram;
+}
+
+PackedColorSequence CountingSort(const PackedColorSequence& colors, const ColorOrder& color_order) {
+  static_assert(static_cast<std::uint64_t>(Color::kRed) == 0b00 && static_cast<std::uint64_t>(Color::kGreen) == 0b01 &&
+                    static_cast<std::uint64_t>(Color::kBlue) == 0b10,
+                "Packed counting relies on the color values");
+
+  const auto histogram = CountColors(colors);
+
+  PackedColorSequence sorted_colors;
+  sorted_colors.Reserve(colors.Size());
+
+  for (const Color color : color_order) {
+    sorted_colors.Append(histogram[static_cast<std::size_t>(color)], color);
+  }
+
+  return sorted_colors;
+}
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <color.hpp>
+#include <color_histogram.hpp>
+#include <counting_sort.hpp>
+
+namespace proud_color_sorter {
+
+/// Sequence of colors packed by 2 bits per color, i. e. 32 colors per 64-bit word.
+///
+/// Color at index \c i is stored in bits `[2 * (i % 32), 2 * (i % 32) + 2)` of word `i / 32`. Unused bits of the last
+/// word are always zero.
+class PackedColorSequence {
+ public:
+  /// An immutable iterator. Dereferences to \ref Color by value.
+  class ConstIterator;
+
+  static constexpr std::size_t kBitsPerColor = 2;
+  static constexpr std::size_t kColorsPerWord = 64 / kBitsPerColor;
+
+  PackedColorSequence() = default;
+
+  /// Packs colors from range [\a first, \a last).
+  PackedColorSequence(const Color* first, const Color* last);
+
+  /// Returns the number of colors in the sequence.
+  [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+  /// Returns \c true if the sequence has no colors.
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  /// Returns color at \a index.
+  [[nodiscard]] Color Get(std::size_t index) const noexcept;
+
+  /// Replaces color at \a index with \a color.
+  void Set(std::size_t index, Color color) noexcept;
+
+  /// Appends a \a color to the end.
+  void PushBack(Color color);
+
+  /// Appends colors from range [\a first, \a last) to the end, packing a whole word at a time. Memory grows
+  /// geometrically like with \ref PushBack, call \ref Reserve to allocate it at once.
+  void Append(const Color* first, const Color* last);
+
+  /// Appends a run of \a count colors equal to \a color to the end, writing a whole word at a time.
+  void Append(std::size_t count, Color color);
+
+  /// Reserves memory for at least \a size colors.
+  void Reserve(std::size_t size);
+
+  /// Removes all colors.
+  void Clear() noexcept;
+
+  /// Unpacks colors to \a out, which must have room for \ref Size colors.
+  void Unpack(Color* out) const noexcept;
+
+  /// Returns packed words.
+  [[nodiscard]] const std::vector<std::uint64_t>& Words() const noexcept { return words_; }
+
+  /// Returns \a ConstIterator pointing to the first color.
+  [[nodiscard]] ConstIterator begin() const noexcept;  // NOLINT
+
+  /// Returns \a ConstIterator pointing to the color after the last.
+  [[nodiscard]] ConstIterator end() const noexcept;  // NOLINT
+
+  [[nodiscard]] friend bool operator==(const PackedColorSequence& lhs, const PackedColorSequence& rhs) {
+    return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+  }
+
+  [[nodiscard]] friend bool operator!=(const PackedColorSequence& lhs, const PackedColorSequence& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  std::vector<std::uint64_t> words_;
+  std::size_t size_ = 0;
+};
+
+class PackedColorSequence::ConstIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;  // NOLINT
+  using value_type = Color;                                   // NOLINT
+  using pointer = void;                                       // NOLINT
+  using reference = Color;                                    // NOLINT
+  using difference_type = std::ptrdiff_t;                     // NOLINT
+
+  ConstIterator(const PackedColorSequence* sequence, std::size_t index) : sequence_(sequence), index_(index) {}
+
+  reference operator*() const { return sequence_->Get(index_); }
+
+  reference operator[](difference_type offset) const {
+    return sequence_->Get(static_cast<std::size_t>(static_cast<difference_type>(index_) + offset));
+  }
+
+  ConstIterator& operator++() {
+    ++index_;
+    return *this;
+  }
+
+  [[nodiscard]] ConstIterator operator++(int) {
+    ConstIterator it{sequence_, index_};
+    ++index_;
+    return it;
+  }
+
+  ConstIterator& operator--() {
+    --index_;
+    return *this;
+  }
+
+  [[nodiscard]] ConstIterator operator--(int) {
+    ConstIterator it{sequence_, index_};
+    --index_;
+    return it;
+  }
+
+  ConstIterator& operator+=(difference_type n) {
+    index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+    return *this;
+  }
+
+  ConstIterator& operator-=(difference_type n) { return *this += -n; }
+
+  [[nodiscard]] friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ == rhs.index_;
+  }
+
+  [[nodiscard]] friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ != rhs.index_;
+  }
+
+  [[nodiscard]] friend bool operator<(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ < rhs.index_;
+  }
+
+  [[nodiscard]] friend bool operator<=(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ <= rhs.index_;
+  }
+
+  [[nodiscard]] friend bool operator>(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ > rhs.index_;
+  }
+
+  [[nodiscard]] friend bool operator>=(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ >= rhs.index_;
+  }
+
+  [[nodiscard]] friend ConstIterator operator+(ConstIterator lhs, difference_type rhs) { return lhs += rhs; }
+
+  [[nodiscard]] friend ConstIterator operator+(difference_type lhs, ConstIterator rhs) { return rhs += lhs; }
+
+  [[nodiscard]] friend ConstIterator operator-(ConstIterator lhs, difference_type rhs) { return lhs -= rhs; }
+
+  [[nodiscard]] friend difference_type operator-(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+  }
+
+ private:
+  const PackedColorSequence* sequence_ = nullptr;
+  std::size_t index_ = 0;
+};
+
+inline PackedColorSequence::ConstIterator PackedColorSequence::begin() const noexcept {  // NOLINT
+  return ConstIterator{this, 0};
+}
+
+inline PackedColorSequence::ConstIterator PackedColorSequence::end() const noexcept {  // NOLINT
+  return ConstIterator{this, size_};
+}
+
+/// Counts colors of a packed sequence with popcount on whole 64-bit words.
+ColorHistogram CountColors(const PackedColorSequence& colors) noexcept;
+
+/// Sorts packed \a colors using \a color_order.
+///
+/// Creates a new packed sequence, which is emitted by whole words without unpacking.
+PackedColorSequence CountingSort(const PackedColorSequence& colors, const ColorOrder& color_order);
+
+}  // namespace proud_color_sorter
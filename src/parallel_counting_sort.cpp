@@ -0,0 +1,131 @@
+#include <parallel_counting_sort.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include <color_histogram.hpp>
+
+namespace proud_color_sorter {
+
+namespace detail {
+
+std::size_t GetThreadCount(const ParallelSortOptions& options, const std::size_t size) {
+  std::size_t thread_count = options.thread_count;
+
+  if (thread_count == 0) {
+    thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  return std::min(thread_count, std::max<std::size_t>(size, 1));
+}
+
+/// Runs `task(i)` for every i in [0, \a thread_count) on its own thread and waits for all of them.
+template <typename Task>
+void RunOnThreads(const std::size_t thread_count, Task task) {
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+
+  try {
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      threads.emplace_back(task, i);
+    }
+  } catch (...) {
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    throw;
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+/// Counts colors of range [\a first, \a last), checking them if \a check_colors is set.
+ColorHistogram CountChunk(const Color* first, const Color* last, const bool check_colors) {
+  if (!check_colors) {
+    return CountColorsSimd(first, last);
+  }
+
+  const auto histogram = CountColorsChecked(first, last);
+
+  if (!histogram.has_value()) {
+    throw std::runtime_error{"Input holds a byte, which isn't a color"};
+  }
+
+  return *histogram;
+}
+
+}  // namespace detail
+
+std::vector<Color> ParallelCountingSort(const std::vector<Color>& colors, const ColorOrder& color_order,
+                                        const ParallelSortOptions& options) {
+  std::vector<Color> sorted_colors(colors.size());
+  ParallelCountingSort(colors.data(), colors.data() + colors.size(), color_order, sorted_colors.data(), options);
+  return sorted_colors;
+}
+
+void ParallelCountingSort(const Color* first, const Color* last, const ColorOrder& color_order, Color* out,
+                          const ParallelSortOptions& options) {
+  const auto size = static_cast<std::size_t>(last - first);
+  const std::size_t thread_count = detail::GetThreadCount(options, size);
+
+  if (size < options.serial_threshold || thread_count == 1) {
+    FillSortedColors(detail::CountChunk(first, last, options.check_colors), color_order, out);
+    return;
+  }
+
+  const std::size_t chunk_size = (size + thread_count - 1) / thread_count;
+  std::vector<ColorHistogram> histograms(thread_count);
+  std::vector<std::optional<ColorHistogram>> checked_histograms(options.check_colors ? thread_count : 0);
+
+  // Counting is finished on all threads before any of them starts writing, so `out` may alias the input.
+  detail::RunOnThreads(thread_count, [&](const std::size_t index) {
+    const Color* chunk_first = first + std::min(index * chunk_size, size);
+    const Color* chunk_last = first + std::min((index + 1) * chunk_size, size);
+
+    if (options.check_colors) {
+      checked_histograms[index] = CountColorsChecked(chunk_first, chunk_last);
+    } else {
+      histograms[index] = CountColorsSimd(chunk_first, chunk_last);
+    }
+  });
+
+  for (std::size_t i = 0; i < checked_histograms.size(); ++i) {
+    if (!checked_histograms[i].has_value()) {
+      throw std::runtime_error{"Input holds a byte, which isn't a color"};
+    }
+
+    histograms[i] = *checked_histograms[i];
+  }
+
+  // offsets[i][color] is where thread i starts writing its part of the `color` run.
+  std::vector<ColorHistogram> offsets(thread_count);
+  std::size_t run_first = 0;
+
+  for (const Color color : color_order) {
+    const auto color_index = static_cast<std::size_t>(color);
+
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      offsets[i][color_index] = run_first;
+      run_first += histograms[i][color_index];
+    }
+  }
+
+  detail::RunOnThreads(thread_count, [&](const std::size_t index) {
+    for (const Color color : color_order) {
+      const auto color_index = static_cast<std::size_t>(color);
+
+      if (histograms[index][color_index] != 0) {
+        std::memset(out + offsets[index][color_index], static_cast<int>(color), histograms[index][color_index]);
+      }
+    }
+  });
+}
+
+}  // namespace proud_color_sorter
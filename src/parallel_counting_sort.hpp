@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <color.hpp>
+#include <counting_sort.hpp>
+
+namespace proud_color_sorter {
+
+/// Tuning options of \ref ParallelCountingSort.
+struct ParallelSortOptions {
+  /// Number of worker threads. \c 0 means `std::thread::hardware_concurrency()`.
+  std::size_t thread_count = 0;
+
+  /// Sequences shorter than this are sorted on the calling thread by \ref CountingSort.
+  std::size_t serial_threshold = std::size_t{1} << 20;
+
+  /// If \c true, every byte is checked to be a color by \ref CountColorsChecked while input is counted, and nothing
+  /// is written if one isn't.
+  bool check_colors = false;
+};
+
+/// Sorts \a colors using \a color_order on several threads.
+///
+/// Input is split into chunks, one per thread. Every thread counts its chunk, per-thread histograms are reduced with a
+/// prefix sum and then every thread fills its own slice of the output.
+std::vector<Color> ParallelCountingSort(const std::vector<Color>& colors, const ColorOrder& color_order,
+                                        const ParallelSortOptions& options = {});
+
+/// Sorts colors in range [\a first, \a last) using \a color_order on several threads and writes them to \a out.
+///
+/// \a out must have room for `last - first` colors, it may be equal to \a first to sort in place.
+/// Throws \c std::runtime_error if `options.check_colors` is set and the input holds a byte, which isn't a color.
+void ParallelCountingSort(const Color* first, const Color* last, const ColorOrder& color_order, Color* out,
+                          const ParallelSortOptions& options = {});
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,6 @@
+#pragma once
+
+/// Defined if x86 kernels, which are compiled with target attributes and picked at runtime, are available.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PROUD_COLOR_SORTER_X86_KERNELS
+#endif
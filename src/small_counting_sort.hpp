@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace proud_color_sorter {
+
+/// Number of occurrences of each key of a domain of \a DomainSize keys, indexed by the underlying value of the key.
+template <std::size_t DomainSize>
+using KeyHistogram = std::array<std::size_t, DomainSize>;
+
+namespace detail {
+
+/// Domains up to this size are counted by \ref CountKeysInRegisters, larger ones by \ref CountKeysInterleaved.
+constexpr std::size_t kRegisterHistogramMaxSize = 8;
+
+/// Number of keys \ref CountKeysInRegisters counts at once, so 8-bit counters never overflow.
+constexpr std::size_t kRegisterBlockSize = std::numeric_limits<std::uint8_t>::max();
+
+/// Number of histograms \ref CountKeysInterleaved spreads consecutive keys over.
+constexpr std::size_t kInterleavedHistograms = 4;
+
+/// Number of keys counted by \ref CountKeysInterleaved before its 32-bit counters are flushed, so they never overflow.
+constexpr std::size_t kInterleavedBlockSize = std::size_t{1} << 30;
+
+/// Largest domain \ref CountKeysInterleaved counts. Its histograms live on the stack and take 24 KiB at this size.
+constexpr std::size_t kInterleavedHistogramMaxSize = 1024;
+
+template <typename Key>
+constexpr void CheckKeyType() noexcept {
+  static_assert(std::is_enum_v<Key> || std::is_unsigned_v<Key>, "Keys must be enums or unsigned integers");
+}
+
+template <typename Key>
+[[nodiscard]] constexpr std::size_t KeyToIndex(const Key key) noexcept {
+  return static_cast<std::size_t>(key);
+}
+
+/// Compares every key against every value of a tiny domain. Keys are taken by blocks short enough for 8-bit
+/// counters, which live in registers: the loop neither waits for store forwarding nor stops the compiler from
+/// vectorizing it.
+template <std::size_t DomainSize, typename Key>
+KeyHistogram<DomainSize> CountKeysInRegisters(const Key* first, const Key* last) noexcept {
+  using Underlying = typename std::conditional_t<std::is_enum_v<Key>, std::underlying_type<Key>,
+                                                 std::remove_cv<Key>>::type;
+
+  KeyHistogram<DomainSize> histogram{};
+
+  while (first != last) {
+    const std::size_t block_size = std::min(static_cast<std::size_t>(last - first), kRegisterBlockSize);
+
+    for (std::size_t value = 0; value < DomainSize; ++value) {
+      // Compares in the key's own width, so a vector register holds as many keys as possible.
+      const auto key_value = static_cast<Underlying>(value);
+      std::uint8_t count = 0;
+
+      for (std::size_t i = 0; i < block_size; ++i) {
+        const bool is_equal = static_cast<Underlying>(first[i]) == key_value;
+        count = static_cast<std::uint8_t>(count + static_cast<std::uint8_t>(is_equal));
+      }
+
+      histogram[value] += count;
+    }
+
+    first += block_size;
+  }
+
+  return histogram;
+}
+
+/// Counts consecutive keys in different histograms, so runs of equal keys don't serialize on incrementing the same
+/// counter through memory.
+template <std::size_t DomainSize, typename Key>
+KeyHistogram<DomainSize> CountKeysInterleaved(const Key* first, const Key* last) noexcept {
+  static_assert(DomainSize <= kInterleavedHistogramMaxSize, "Histograms of the domain don't fit on the stack");
+
+  KeyHistogram<DomainSize> histogram{};
+  std::array<std::array<std::uint32_t, DomainSize>, kInterleavedHistograms> partial_histograms;
+
+  while (first != last) {
+    const Key* block_last = first + std::min(static_cast<std::size_t>(last - first), kInterleavedBlockSize);
+
+    for (auto& partial_histogram : partial_histograms) {
+      partial_histogram.fill(0);
+    }
+
+    for (; static_cast<std::size_t>(block_last - first) >= kInterleavedHistograms; first += kInterleavedHistograms) {
+      for (std::size_t i = 0; i < kInterleavedHistograms; ++i) {
+        ++partial_histograms[i][KeyToIndex(first[i])];
+      }
+    }
+
+    for (; first != block_last; ++first) {
+      ++partial_histograms[0][KeyToIndex(*first)];
+    }
+
+    for (const auto& partial_histogram : partial_histograms) {
+      for (std::size_t value = 0; value < DomainSize; ++value) {
+        histogram[value] += partial_histogram[value];
+      }
+    }
+  }
+
+  return histogram;
+}
+
+}  // namespace detail
+
+/// Counts keys in range [\a first, \a last), which must be less than \a DomainSize.
+///
+/// \a Key is an enum or an unsigned integer. Tiny domains are counted in registers, larger ones in several interleaved
+/// histograms on the stack, so \a DomainSize is at most \ref detail::kInterleavedHistogramMaxSize.
+template <std::size_t DomainSize, typename Key>
+KeyHistogram<DomainSize> CountKeys(const Key* first, const Key* last) noexcept;
+
+/// Writes keys counted in \a histogram to \a out as runs following \a order, which iterates over keys by rank like
+/// \ref Order. Returns pointer to the element after the last written one.
+template <std::size_t DomainSize, typename Key, typename OrderType>
+Key* FillSortedKeys(const KeyHistogram<DomainSize>& histogram, const OrderType& order, Key* out) noexcept;
+
+/// Sorts keys in range [\a first, \a last), which must be less than \a DomainSize, using \a order and writes them to
+/// \a out.
+///
+/// Generalization of \ref CountingSort to any small domain, e. g. `SmallCountingSort<256>` sorts bytes.
+/// \a out must have room for `last - first` keys, it may be equal to \a first to sort in place.
+template <std::size_t DomainSize, typename Key, typename OrderType>
+void SmallCountingSort(const Key* first, const Key* last, const OrderType& order, Key* out) noexcept;
+
+template <std::size_t DomainSize, typename Key>
+KeyHistogram<DomainSize> CountKeys(const Key* first, const Key* last) noexcept {
+  detail::CheckKeyType<Key>();
+  static_assert(DomainSize > 0, "Domain must not be empty");
+
+  if constexpr (DomainSize <= detail::kRegisterHistogramMaxSize) {
+    return detail::CountKeysInRegisters<DomainSize>(first, last);
+  } else {
+    return detail::CountKeysInterleaved<DomainSize>(first, last);
+  }
+}
+
+template <std::size_t DomainSize, typename Key, typename OrderType>
+Key* FillSortedKeys(const KeyHistogram<DomainSize>& histogram, const OrderType& order, Key* out) noexcept {
+  detail::CheckKeyType<Key>();
+
+  for (const Key key : order) {
+    const std::size_t key_count = histogram[detail::KeyToIndex(key)];
+
+    if constexpr (sizeof(Key) == 1) {
+      if (key_count != 0) {
+        std::memset(out, static_cast<int>(key), key_count);
+      }
+    } else {
+      std::fill_n(out, key_count, key);
+    }
+
+    out += key_count;
+  }
+
+  return out;
+}
+
+template <std::size_t DomainSize, typename Key, typename OrderType>
+void SmallCountingSort(const Key* first, const Key* last, const OrderType& order, Key* out) noexcept {
+  FillSortedKeys<DomainSize>(CountKeys<DomainSize>(first, last), order, out);
+}
+
+}  // namespace proud_color_sorter
@@ -0,0 +1,75 @@
+#include <sorted_color_accumulator.hpp>
+
+namespace proud_color_sorter {
+
+void SortedColorAccumulator::Insert(const Color color, const std::size_t count) noexcept {
+  counts_[color_order_.GetRank(color)] += count;
+  size_ += count;
+}
+
+void SortedColorAccumulator::Insert(const Color* first, const Color* last) noexcept {
+  const ColorHistogram histogram = CountColorsSimd(first, last);
+
+  for (std::size_t i = 0; i < histogram.size(); ++i) {
+    Insert(static_cast<Color>(i), histogram[i]);
+  }
+}
+
+bool SortedColorAccumulator::Remove(const Color color, const std::size_t count) noexcept {
+  std::size_t& color_count = counts_[color_order_.GetRank(color)];
+
+  if (color_count < count) {
+    return false;
+  }
+
+  color_count -= count;
+  size_ -= count;
+
+  return true;
+}
+
+void SortedColorAccumulator::Merge(const SortedColorAccumulator& other) noexcept {
+  for (std::size_t rank = 0; rank < kColorSize; ++rank) {
+    Insert(other.color_order_.GetElement(rank), other.counts_[rank]);
+  }
+}
+
+void SortedColorAccumulator::Clear() noexcept {
+  counts_.fill(0);
+  size_ = 0;
+}
+
+std::size_t SortedColorAccumulator::Rank(const Color color) const noexcept {
+  const std::size_t color_rank = color_order_.GetRank(color);
+  std::size_t preceding = 0;
+
+  for (std::size_t rank = 0; rank < color_rank; ++rank) {
+    preceding += counts_[rank];
+  }
+
+  return preceding;
+}
+
+Color SortedColorAccumulator::Select(std::size_t index) const noexcept {
+  for (std::size_t rank = 0; rank + 1 < kColorSize; ++rank) {
+    if (index < counts_[rank]) {
+      return color_order_.GetElement(rank);
+    }
+
+    index -= counts_[rank];
+  }
+
+  return color_order_.GetElement(kColorSize - 1);
+}
+
+ColorHistogram SortedColorAccumulator::GetHistogram() const noexcept {
+  ColorHistogram histogram{};
+
+  for (std::size_t rank = 0; rank < kColorSize; ++rank) {
+    histogram[static_cast<std::size_t>(color_order_.GetElement(rank))] = counts_[rank];
+  }
+
+  return histogram;
+}
+
+}  // namespace proud_color_sorter
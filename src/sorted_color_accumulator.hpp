@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <color.hpp>
+#include <color_histogram.hpp>
+#include <counting_sort.hpp>
+#include <sorted_runs.hpp>
+
+namespace proud_color_sorter {
+
+/// Multiset of colors, which is kept sorted by a \ref ColorOrder while colors arrive and leave one at a time.
+///
+/// Only the number of colors of every rank is stored, so updates and queries about the sorted sequence take time
+/// proportional to the number of colors, not to the size of the sequence.
+class SortedColorAccumulator {
+ public:
+  explicit SortedColorAccumulator(const ColorOrder& color_order) noexcept : color_order_(color_order) {}
+
+  /// Adds \a count colors equal to \a color.
+  void Insert(Color color, std::size_t count = 1) noexcept;
+
+  /// Adds colors from range [\a first, \a last).
+  void Insert(const Color* first, const Color* last) noexcept;
+
+  /// Removes \a count colors equal to \a color and returns \c true.
+  /// If there are less of them, does nothing and returns \c false.
+  bool Remove(Color color, std::size_t count = 1) noexcept;
+
+  /// Adds all colors of \a other, which may follow another order.
+  void Merge(const SortedColorAccumulator& other) noexcept;
+
+  /// Removes all colors.
+  void Clear() noexcept;
+
+  /// Returns the number of colors.
+  [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+  /// Returns \c true if there are no colors.
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  /// Returns the number of colors equal to \a color.
+  [[nodiscard]] std::size_t Count(const Color color) const noexcept {
+    return counts_[color_order_.GetRank(color)];
+  }
+
+  /// Returns the number of colors ordered before \a color, i. e. index of its first occurrence in the sorted sequence.
+  [[nodiscard]] std::size_t Rank(Color color) const noexcept;
+
+  /// Returns color at \a index of the sorted sequence, \a index must be less than \ref Size.
+  [[nodiscard]] Color Select(std::size_t index) const noexcept;
+
+  /// Returns the number of occurrences of each color, indexed by the underlying value of \ref Color.
+  [[nodiscard]] ColorHistogram GetHistogram() const noexcept;
+
+  /// Returns runs of the sorted sequence.
+  [[nodiscard]] SortedRuns Snapshot() const noexcept { return SortedRuns{GetHistogram(), color_order_}; }
+
+  /// Returns order colors are sorted by.
+  [[nodiscard]] const ColorOrder& GetOrder() const noexcept { return color_order_; }
+
+ private:
+  ColorOrder color_order_;
+
+  /// Number of colors of every rank.
+  std::array<std::size_t, kColorSize> counts_{};
+  std::size_t size_ = 0;
+};
+
+}  // namespace proud_color_sorter
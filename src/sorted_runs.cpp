@@ -0,0 +1,60 @@
+#include <sorted_runs.hpp>
+
+namespace proud_color_sorter {
+
+SortedRuns::SortedRuns(const ColorHistogram& histogram, const ColorOrder& color_order) noexcept
+    : color_order_(color_order) {
+  for (std::size_t rank = 0; rank < kColorSize; ++rank) {
+    const Color color = color_order.GetElement(rank);
+    const std::size_t count = histogram[static_cast<std::size_t>(color)];
+    runs_[rank] = ColorRun{color, size_, count};
+    size_ += count;
+  }
+}
+
+Color SortedRuns::Get(const std::size_t index) const noexcept {
+  for (const ColorRun& run : runs_) {
+    if (index < run.offset + run.count) {
+      return run.color;
+    }
+  }
+
+  return runs_.back().color;
+}
+
+std::vector<Color> SortedRuns::Materialize() const {
+  std::vector<Color> colors(size_);
+  MaterializeTo(colors.data());
+  return colors;
+}
+
+Color* SortedRuns::MaterializeTo(Color* out) const noexcept {
+  ColorHistogram histogram{};
+
+  for (const ColorRun& run : runs_) {
+    histogram[static_cast<std::size_t>(run.color)] = run.count;
+  }
+
+  return FillSortedColors(histogram, color_order_, out);
+}
+
+SortedRuns CountingSortRuns(const std::vector<Color>& colors, const ColorOrder& color_order) noexcept {
+  return CountingSortRuns(colors.data(), colors.data() + colors.size(), color_order);
+}
+
+SortedRuns CountingSortRuns(const Color* first, const Color* last, const ColorOrder& color_order) noexcept {
+  return SortedRuns{CountColorsSimd(first, last), color_order};
+}
+
+std::array<SortedRuns, kColorOrderCount> CountingSortRunsAllOrders(const Color* first, const Color* last) noexcept {
+  const ColorHistogram histogram = CountColorsSimd(first, last);
+  std::array<SortedRuns, kColorOrderCount> all_runs;
+
+  for (std::size_t i = 0; i < kAllColorOrders.size(); ++i) {
+    all_runs[i] = SortedRuns{histogram, kAllColorOrders[i]};
+  }
+
+  return all_runs;
+}
+
+}  // namespace proud_color_sorter
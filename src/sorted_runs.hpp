@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <color.hpp>
+#include <color_histogram.hpp>
+#include <counting_sort.hpp>
+
+namespace proud_color_sorter {
+
+/// Run of equal colors in a sorted sequence.
+struct ColorRun {
+  Color color = Color::kRed;
+
+  /// Index of the first color of the run in the sorted sequence.
+  std::size_t offset = 0;
+
+  /// Number of colors in the run.
+  std::size_t count = 0;
+};
+
+/// Sorted color sequence described by its runs, one per color, instead of elements.
+///
+/// Provides a lazy iterator view over the sorted elements and materializes them only on demand.
+class SortedRuns {
+ public:
+  /// An immutable forward iterator over sorted colors. Dereferences to \ref Color by value.
+  class ConstIterator;
+
+  SortedRuns() = default;
+
+  /// Builds runs of colors counted in \a histogram following \a color_order.
+  SortedRuns(const ColorHistogram& histogram, const ColorOrder& color_order) noexcept;
+
+  /// Returns runs ordered by rank, empty runs included.
+  [[nodiscard]] const std::array<ColorRun, kColorSize>& GetRuns() const noexcept { return runs_; }
+
+  /// Returns run of \a color.
+  [[nodiscard]] const ColorRun& GetRun(const Color color) const noexcept { return runs_[color_order_.GetRank(color)]; }
+
+  /// Returns order the runs follow.
+  [[nodiscard]] const ColorOrder& GetOrder() const noexcept { return color_order_; }
+
+  /// Returns number of colors in the sorted sequence.
+  [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+  /// Returns color at \a index of the sorted sequence.
+  [[nodiscard]] Color Get(std::size_t index) const noexcept;
+
+  /// Returns sorted colors.
+  [[nodiscard]] std::vector<Color> Materialize() const;
+
+  /// Writes sorted colors to \a out, which must have room for \ref Size colors.
+  /// Returns pointer to the element after the last written one.
+  Color* MaterializeTo(Color* out) const noexcept;
+
+  /// Returns \a ConstIterator pointing to the first sorted color.
+  [[nodiscard]] ConstIterator begin() const noexcept;  // NOLINT
+
+  /// Returns \a ConstIterator pointing to the color after the last.
+  [[nodiscard]] ConstIterator end() const noexcept;  // NOLINT
+
+ private:
+  std::array<ColorRun, kColorSize> runs_{};
+  ColorOrder color_order_;
+  std::size_t size_ = 0;
+};
+
+class SortedRuns::ConstIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;  // NOLINT
+  using value_type = Color;                             // NOLINT
+  using pointer = void;                                 // NOLINT
+  using reference = Color;                              // NOLINT
+  using difference_type = std::ptrdiff_t;               // NOLINT
+
+  ConstIterator(const std::array<ColorRun, kColorSize>* runs, std::size_t run_index, std::size_t index)
+      : runs_(runs), run_index_(run_index), index_(index) {
+    SkipFinishedRuns();
+  }
+
+  reference operator*() const { return (*runs_)[run_index_].color; }
+
+  ConstIterator& operator++() {
+    ++index_;
+    SkipFinishedRuns();
+    return *this;
+  }
+
+  [[nodiscard]] ConstIterator operator++(int) {
+    ConstIterator it = *this;
+    ++*this;
+    return it;
+  }
+
+  [[nodiscard]] friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ == rhs.index_;
+  }
+
+  [[nodiscard]] friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs) {
+    return lhs.index_ != rhs.index_;
+  }
+
+ private:
+  void SkipFinishedRuns() {
+    while (run_index_ < kColorSize && index_ >= (*runs_)[run_index_].offset + (*runs_)[run_index_].count) {
+      ++run_index_;
+    }
+  }
+
+ private:
+  const std::array<ColorRun, kColorSize>* runs_ = nullptr;
+  std::size_t run_index_ = 0;
+  std::size_t index_ = 0;
+};
+
+inline SortedRuns::ConstIterator SortedRuns::begin() const noexcept {  // NOLINT
+  return ConstIterator{&runs_, 0, 0};
+}
+
+inline SortedRuns::ConstIterator SortedRuns::end() const noexcept {  // NOLINT
+  return ConstIterator{&runs_, kColorSize, size_};
+}
+
+/// Sorts \a colors using \a color_order without writing sorted elements.
+///
+/// Only counts the input, so consumers that need counts or run boundaries skip the O(n) output.
+SortedRuns CountingSortRuns(const std::vector<Color>& colors, const ColorOrder& color_order) noexcept;
+
+/// Sorts colors in range [\a first, \a last) using \a color_order without writing sorted elements.
+SortedRuns CountingSortRuns(const Color* first, const Color* last, const ColorOrder& color_order) noexcept;
+
+/// Sorts colors in range [\a first, \a last) using every order without writing sorted elements.
+///
+/// Counts the input once, runs of order `kAllColorOrders[i]` are at index \c i, see \ref GetColorOrderIndex.
+std::array<SortedRuns, kColorOrderCount> CountingSortRunsAllOrders(const Color* first, const Color* last) noexcept;
+
+}  // namespace proud_color_sorter
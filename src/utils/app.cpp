@@ -1,24 +1,84 @@
 #include <utils/app.hpp>
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <csignal>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
 #include <thread>
 #include <vector>
 
 #include <fmt/core.h>
 #include <fmt/format.h>
 
+#include <buffer_pool.hpp>
+#include <color_histogram.hpp>
 #include <counting_sort.hpp>
-#include <mpsc_queue.hpp>
+#include <mpmc_bounded_queue.hpp>
+#include <mpsc_bounded_queue.hpp>
 #include <order.hpp>
-#include <utils/color_formatter.hpp>
+#include <sorted_runs.hpp>
+#include <utils/color_reader.hpp>
+#include <utils/color_writer.hpp>
+#include <utils/file_sort.hpp>
 #include <utils/random_generator.hpp>
 
 namespace proud_color_sorter::utils {
 
-using Channel = MPSCUnboundedBlockingQueue<std::vector<Color>>;
+namespace detail {
+
+/// Generated color sequence tagged with its number in generation order.
+struct ColorSequence {
+  std::uint64_t id = 0;
+  std::vector<Color> colors;
+};
+
+}  // namespace detail
+
+/// Producers are blocked while the channel is full, so they can't outrun sorting workers.
+using Channel = MPMCBoundedBlockingQueue<detail::ColorSequence>;
+
+/// Buffers of sorted sequences are handed back to producers through the pool.
+///
+/// \ref Channel is bounded, so the number of sequences in flight is bounded too, and the pool stops allocating once it
+/// holds a buffer for each of them, grown to the longest sequence.
+using ColorBufferPool = BufferPool<Color>;
+
+namespace detail {
+
+/// Text made by a sorting worker for the output thread.
+struct OutputChunk {
+  /// Id of the sequence the text belongs to, used only if order is preserved.
+  std::uint64_t id = 0;
+  ColorWriter text;
+
+  /// Set by a worker, which has drained the channel, so the output thread doesn't hold the text back.
+  bool flush = false;
+};
+
+}  // namespace detail
+
+/// Bounded, so sorting workers are blocked when they get too far ahead of the output thread.
+using OutputQueue = MPSCBoundedLockFreeQueue<detail::OutputChunk>;
+
+/// Buffers of written text chunks are handed back to sorting workers through the pool.
+using TextBufferPool = BufferPool<char, TextBuffer::allocator_type>;
 
 namespace detail {
 
@@ -62,45 +122,426 @@ class ThreadExceptionHandle {
   std::exception_ptr exception_;
 };
 
-std::vector<Color> GenerateColors(RandomGenerator<std::uint64_t>& size_generator,
-                                  RandomGenerator<std::uint64_t>& color_generator) {
-  auto color_size = size_generator.Generate();
-  std::vector<Color> colors;
-  colors.reserve(color_size);
-
-  for (std::size_t i = 0; i < color_size; ++i) {
+/// Appends \a size random colors to empty \a colors, which is expected to have enough capacity.
+void GenerateColors(const std::size_t size, RandomGenerator<std::uint64_t>& color_generator,
+                    std::vector<Color>& colors) {
+  for (std::size_t i = 0; i < size; ++i) {
     auto generated = color_generator.Generate();
     colors.emplace_back(static_cast<Color>(generated));
   }
+}
+
+void GenerateColors(const std::size_t size, ColorGenerator& color_generator, std::vector<Color>& colors) {
+  colors.resize(size);
+  color_generator.Generate(colors.data(), colors.data() + colors.size());
+}
+
+/// Owns a file descriptor opened for reading, \c "-" stands for \c STDIN.
+class InputFile {
+ public:
+  explicit InputFile(const std::string& path) : fd_(path == "-" ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY)) {
+    if (fd_ < 0) {
+      throw std::system_error{errno, std::generic_category(), "Failed to open input '" + path + "'"};
+    }
+  }
+
+  InputFile(const InputFile& other) = delete;
+
+  InputFile& operator=(const InputFile& other) = delete;
+
+  ~InputFile() {
+    if (fd_ != STDIN_FILENO) {
+      ::close(fd_);
+    }
+  }
+
+  [[nodiscard]] int Get() const noexcept { return fd_; }
+
+ private:
+  const int fd_;
+};
+
+/// What a single thread of a pipeline stage has processed.
+struct StageStats {
+  /// Sequences for generating and sorting stages, chunks of text for the output stage.
+  std::size_t items = 0;
+
+  /// Colors for generating and sorting stages, bytes for the output stage.
+  std::size_t units = 0;
+
+  /// Time spent on the stage's own work, i. e. not waiting for queues.
+  std::chrono::duration<double> busy{0};
+
+  std::chrono::duration<double> elapsed{0};
+};
+
+/// Adds time spent in its scope to a duration, even if the scope is left by an exception.
+class ScopeTimer {
+ public:
+  explicit ScopeTimer(std::chrono::duration<double>& total)
+      : total_(total), start_(std::chrono::steady_clock::now()) {}
+
+  ScopeTimer(const ScopeTimer& other) = delete;
+
+  ScopeTimer& operator=(const ScopeTimer& other) = delete;
+
+  ~ScopeTimer() { total_ += std::chrono::steady_clock::now() - start_; }
+
+ private:
+  std::chrono::duration<double>& total_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+/// Tags sequences with consecutive ids as they are put to the channel.
+///
+/// An id is taken under a lock held until its sequence is in the channel, so workers take sequences in id order. Hence
+/// the oldest sequence not yet written is never stuck in the channel behind ones held back by \ref ReorderWindow.
+class SequenceIds {
+ public:
+  /// Returns \c false if the channel is closed.
+  bool Put(Channel& channel, std::vector<Color> colors) {
+    std::lock_guard lock{lock_};
+    return channel.Put(ColorSequence{next_id_++, std::move(colors)});
+  }
+
+ private:
+  std::mutex lock_;
+  std::uint64_t next_id_ = 0;
+};
+
+/// Limits how far sorting workers may get ahead of the output thread, when order is preserved.
+///
+/// The output thread holds back chunks, which came ahead of their turn. Workers wait before sending a chunk more than
+/// \a size sequences ahead of the next one to write, so at most \a size chunks are held back.
+class ReorderWindow {
+ public:
+  explicit ReorderWindow(const std::uint64_t size) : size_(size) {}
 
-  return colors;
+  /// Blocks caller until sequence \a id fits in the window or the window is closed.
+  void Enter(const std::uint64_t id) {
+    std::unique_lock lock{lock_};
+    moved_.wait(lock, [this, id]() { return is_closed_ || id < next_id_ + size_; });
+  }
+
+  /// Called by the output thread once all sequences before \a next_id are written.
+  void MoveTo(const std::uint64_t next_id) {
+    {
+      std::lock_guard lock{lock_};
+      next_id_ = next_id;
+    }
+
+    moved_.notify_all();
+  }
+
+  /// Stops blocking workers. Must be called once the channel is cancelled: dropped sequences are never written, so the
+  /// window wouldn't move anymore.
+  void Close() {
+    {
+      std::lock_guard lock{lock_};
+      is_closed_ = true;
+    }
+
+    moved_.notify_all();
+  }
+
+ private:
+  const std::uint64_t size_;
+  std::mutex lock_;
+  std::condition_variable moved_;
+  std::uint64_t next_id_ = 0;
+  bool is_closed_ = false;
+};
+
+/// Writes text chunks made by sorting workers to \c STDOUT on a dedicated thread.
+///
+/// Chunks are gathered and written once \a flush_size bytes are collected or a worker has drained the channel. If order
+/// must be preserved, chunks are written strictly by sequence ids: chunks which came ahead of their turn wait until all
+/// preceding ones are written, and \a reorder_window is moved past written ones. Buffers of written chunks are handed
+/// back to workers through \a text_buffers.
+void WriteOutput(OutputQueue& output, TextBufferPool& text_buffers, const bool preserve_order,
+                 ReorderWindow& reorder_window, const std::size_t flush_size, StageStats& stats) {
+  const ScopeTimer elapsed_timer{stats.elapsed};
+  ColorWriter ready{flush_size};
+  std::map<std::uint64_t, ColorWriter> pending;
+  std::uint64_t next_id = 0;
+
+  const auto write_ready = [&ready, &stats]() {
+    ScopeTimer busy_timer{stats.busy};
+    ++stats.items;
+    stats.units += ready.Size();
+    ready.FlushTo(STDOUT_FILENO);
+  };
+
+  while (auto chunk = output.Take()) {
+    if (!preserve_order) {
+      ready.Append(chunk->text.View());
+      text_buffers.Release(chunk->text.ReleaseBuffer());
+    } else if (chunk->id != next_id) {
+      pending.emplace(chunk->id, std::move(chunk->text));
+    } else {
+      ready.Append(chunk->text.View());
+      text_buffers.Release(chunk->text.ReleaseBuffer());
+      ++next_id;
+
+      for (auto it = pending.begin(); it != pending.end() && it->first == next_id; it = pending.erase(it)) {
+        ready.Append(it->second.View());
+        text_buffers.Release(it->second.ReleaseBuffer());
+        ++next_id;
+      }
+
+      reorder_window.MoveTo(next_id);
+    }
+
+    if (ready.Size() >= flush_size || (chunk->flush && !ready.IsEmpty())) {
+      write_ready();
+    }
+  }
+
+  // There are gaps in ids if the channel was cancelled.
+  for (auto& [id, text] : pending) {
+    ready.Append(text.View());
+  }
+
+  if (!ready.IsEmpty()) {
+    write_ready();
+  }
+}
+
+/// Appends colors from range [\a first, \a last) in \a format, \a title is used by text only.
+void AppendColors(ColorWriter& text, const OutputFormat format, const std::string_view title, const Color* first,
+                  const Color* last) {
+  if (format == OutputFormat::kText) {
+    text.AppendSequence(title, first, last);
+  } else {
+    text.AppendFrame(first, last, format == OutputFormat::kPacked);
+  }
 }
 
-void Consume(Channel& channel, const ColorOrder& order) {
-  while (true) {
-    auto colors = channel.Take();
+/// Sorts sequences from the channel and passes their text to the output thread. If order is preserved, text of every
+/// sequence is sent on its own once it fits in \a reorder_window.
+void Consume(Channel& channel, const ColorOrder& order, const OutputMode output_mode, const OutputFormat output_format,
+             const bool preserve_order, ReorderWindow& reorder_window, const std::size_t chunk_size,
+             OutputQueue& output, TextBufferPool& text_buffers, ColorBufferPool& color_buffers, StageStats& stats) {
+  constexpr std::size_t kBatchSize = 64;
+
+  const ScopeTimer elapsed_timer{stats.elapsed};
+  std::vector<ColorSequence> batch;
+  batch.reserve(kBatchSize);
+  ColorWriter text{text_buffers.Acquire(chunk_size)};
+  std::size_t taken = 0;
+  bool is_output_open = true;
+  // The order doesn't change, so its kernels are selected once instead of looking up ranks for every sequence.
+  const ColorSortKernels& kernels = GetColorSortKernels(order);
+
+  // Hands the text over to the output thread. The output queue is bounded, so this blocks while it's full.
+  const auto send = [&output, &text, &text_buffers, chunk_size](const std::uint64_t id, const bool flush) {
+    if (!output.Put(OutputChunk{id, std::move(text), flush})) {
+      return false;
+    }
 
-    if (!colors.has_value()) {
-      return;
+    text = ColorWriter{text_buffers.Acquire(chunk_size)};
+    return true;
+  };
+
+  while (is_output_open && (taken = channel.TakeBatch(std::back_inserter(batch), kBatchSize)) > 0) {
+    for (std::size_t i = 0; i < batch.size() && is_output_open; ++i) {
+      auto& colors = batch[i].colors;
+
+      {
+        ScopeTimer busy_timer{stats.busy};
+        Color* first = colors.data();
+        Color* last = colors.data() + colors.size();
+
+        switch (output_mode) {
+          case OutputMode::kFull:
+            AppendColors(text, output_format, "Generated colors", first, last);
+            // The generated sequence is already printed, so it's safe to sort it in place.
+            kernels.counting_sort(first, last, first);
+            AppendColors(text, output_format, "Sorted colors", first, last);
+            break;
+
+          case OutputMode::kSorted:
+            kernels.counting_sort(first, last, first);
+            AppendColors(text, output_format, "Sorted colors", first, last);
+            break;
+
+          case OutputMode::kSummary:
+            // Counts are enough to describe the sorted sequence, so colors aren't moved at all.
+            text.AppendSummary("Sorted colors", SortedRuns{CountColorsSimd(first, last), order});
+            break;
+        }
+
+        ++stats.items;
+        stats.units += colors.size();
+      }
+
+      color_buffers.Release(std::move(colors));
+
+      // A short batch means the channel is drained, so text isn't held back while workers are idle.
+      const bool is_last = i + 1 == batch.size() && taken < kBatchSize;
+
+      if (preserve_order) {
+        reorder_window.Enter(batch[i].id);
+      }
+
+      if (preserve_order || text.Size() >= chunk_size || is_last) {
+        is_output_open = send(batch[i].id, is_last);
+      }
     }
 
-    fmt::print("Generated colors (size={}): {} \n", colors->size(), fmt::join(colors.value(), " "));
-    auto sorted_colors = CountingSort(colors.value(), order);
-    fmt::print("Sorted colors (size={}): {} \n", sorted_colors.size(), fmt::join(sorted_colors, " "));
+    batch.clear();
+  }
+
+  if (!is_output_open) {
+    // The output thread has failed, nothing can be printed anymore.
+    channel.Cancel();
+    reorder_window.Close();
+  } else if (!text.IsEmpty()) {
+    send(0, /*flush=*/true);
   }
 }
 
-void Produce(Channel& channel, const std::size_t max_seq_length) {
-  std::vector<Color> colors;
-  RandomGenerator<std::uint64_t> size_generator{1, max_seq_length};
-  RandomGenerator<std::uint64_t> color_generator{0, kColorSize - 1};
+/// Generates sequences until the app is stopped. Every producer has its own generators, sequence ids are shared
+/// through \a sequence_ids. The channel is cancelled at the end, so \a reorder_window is closed.
+template <typename ColorGeneratorType>
+void Produce(Channel& channel, ColorBufferPool& buffer_pool, RandomGenerator<std::uint64_t>& size_generator,
+             ColorGeneratorType& color_generator, SequenceIds& sequence_ids, ReorderWindow& reorder_window,
+             StageStats& stats) {
+  const ScopeTimer elapsed_timer{stats.elapsed};
 
   do {
-    colors = detail::GenerateColors(size_generator, color_generator);
-    channel.Put(std::move(colors));
+    std::vector<Color> colors;
+
+    {
+      ScopeTimer busy_timer{stats.busy};
+      const std::size_t size = size_generator.Generate();
+      // Recycled buffers keep the capacity they have grown to, so they stop growing once they fit long sequences.
+      colors = buffer_pool.Acquire(size);
+      detail::GenerateColors(size, color_generator, colors);
+    }
+
+    const std::size_t size = colors.size();
+
+    if (!sequence_ids.Put(channel, std::move(colors))) {
+      // Channel is cancelled by another producer or by failed sorting workers.
+      break;
+    }
+
+    ++stats.items;
+    stats.units += size;
   } while (!need_stop.load());
 
   channel.Cancel();
+  reorder_window.Close();
+}
+
+void Produce(Channel& channel, ColorBufferPool& buffer_pool, const std::size_t max_seq_length,
+             const ColorGeneratorKind color_generator_kind, SequenceIds& sequence_ids, ReorderWindow& reorder_window,
+             StageStats& stats) {
+  RandomGenerator<std::uint64_t> size_generator{1, max_seq_length};
+
+  switch (color_generator_kind) {
+    case ColorGeneratorKind::kMersenneTwister: {
+      RandomGenerator<std::uint64_t> color_generator{0, kColorSize - 1};
+      Produce(channel, buffer_pool, size_generator, color_generator, sequence_ids, reorder_window, stats);
+      break;
+    }
+    case ColorGeneratorKind::kXoshiro: {
+      ColorGenerator color_generator;
+      Produce(channel, buffer_pool, size_generator, color_generator, sequence_ids, reorder_window, stats);
+      break;
+    }
+  }
+}
+
+/// Reads sequences until the input ends or the app is stopped. Lengths aren't known in advance, so recycled buffers are
+/// grown by the reader.
+void ReadInput(Channel& channel, ColorBufferPool& buffer_pool, ColorReader& reader, SequenceIds& sequence_ids,
+               ReorderWindow& reorder_window, StageStats& stats) {
+  const ScopeTimer elapsed_timer{stats.elapsed};
+  bool is_input_ended = false;
+
+  while (!need_stop.load()) {
+    auto colors = buffer_pool.Acquire(0);
+
+    {
+      ScopeTimer busy_timer{stats.busy};
+      is_input_ended = !reader.ReadSequence(colors);
+    }
+
+    if (is_input_ended) {
+      break;
+    }
+
+    const std::size_t size = colors.size();
+
+    if (!sequence_ids.Put(channel, std::move(colors))) {
+      break;
+    }
+
+    ++stats.items;
+    stats.units += size;
+  }
+
+  // Once the whole input is read, workers sort and print what is left in the channel. Otherwise it's dropped.
+  if (is_input_ended) {
+    channel.Close();
+  } else {
+    channel.Cancel();
+    reorder_window.Close();
+  }
+}
+
+void PrintProducerStats(const std::vector<StageStats>& producers_stats) {
+  for (std::size_t i = 0; i < producers_stats.size(); ++i) {
+    const auto& stats = producers_stats[i];
+    const double seconds = std::max(stats.elapsed.count(), std::numeric_limits<double>::min());
+
+    fmt::print(stderr, "Producer #{}: {} sequences ({} colors) in {:.3f}s, {:.0f} sequences/s, {:.0f} colors/s.\n", i,
+               stats.items, stats.units, stats.elapsed.count(), static_cast<double>(stats.items) / seconds,
+               static_cast<double>(stats.units) / seconds);
+  }
+}
+
+/// Prints totals of all threads of a stage. The stage, which is busy close to 100% of time, is the bottleneck.
+void PrintStageStats(std::string_view stage, std::string_view items_name, std::string_view units_name,
+                     const std::vector<StageStats>& threads_stats) {
+  StageStats total;
+  double wall_seconds = 0;
+
+  for (const auto& stats : threads_stats) {
+    total.items += stats.items;
+    total.units += stats.units;
+    total.busy += stats.busy;
+    total.elapsed += stats.elapsed;
+    wall_seconds = std::max(wall_seconds, stats.elapsed.count());
+  }
+
+  wall_seconds = std::max(wall_seconds, std::numeric_limits<double>::min());
+  const double busy_percent =
+      100 * total.busy.count() / std::max(total.elapsed.count(), std::numeric_limits<double>::min());
+
+  fmt::print(stderr, "{} stage ({} threads): {} {} ({} {}) in {:.3f}s, {:.0f} {}/s, busy {:.0f}% of time.\n", stage,
+             threads_stats.size(), total.items, items_name, total.units, units_name, wall_seconds,
+             static_cast<double>(total.units) / wall_seconds, units_name, busy_percent);
+}
+
+template <typename T, typename Allocator>
+void PrintBufferPoolStats(std::string_view name, const BufferPool<T, Allocator>& buffer_pool) {
+  const auto stats = buffer_pool.GetStats();
+  fmt::print(stderr, "{} pool: {} buffers acquired, {} allocated, {} released, {} dropped.\n", name,
+             stats.acquisitions, stats.allocations, stats.releases, stats.drops);
+}
+
+void RunFileSort(const Config& config, const ColorOrder& color_order) {
+  ParallelSortOptions options;
+  options.thread_count = config.sort_file_threads;
+
+  const auto stats = config.sort_in_place ? SortFileInPlace(config.sort_file, color_order, options)
+                                           : SortFile(config.sort_file, config.sort_output, color_order, options);
+
+  fmt::print("Sorted {} colors in {:.3f}s, {:.2f} GB/s.\n", stats.size, stats.elapsed.count(),
+             stats.GigabytesPerSecond());
 }
 
 void SignalHandler(int signal) {
@@ -114,39 +555,197 @@ void SignalHandler(int signal) {
 }  // namespace detail
 
 void RunApp(const Config& config) {
+  // Enough to cover sequences and text chunks in flight between stages, extra buffers are freed.
+  constexpr std::size_t kMaxPooledBuffers = 4096;
+
+  // Number of sequences producers may get ahead of sorting workers.
+  constexpr std::size_t kChannelCapacity = 1024;
+
+  // Number of text chunks sorting workers may get ahead of the output thread.
+  constexpr std::size_t kOutputQueueCapacity = 256;
+
+  // Room for text of a single sequence, including both lines of \ref OutputMode::kFull.
+  constexpr std::size_t kLineOverhead = 64;
+
+  // Kernels are looked up by order, which is found only for a permutation of colors.
+  std::array<bool, kColorSize> is_color_used{};
+
+  for (const Color color : config.color_order) {
+    const auto index = static_cast<std::size_t>(color);
+
+    if (index >= kColorSize || is_color_used[index]) {
+      throw std::invalid_argument{"Color order must hold every color exactly once"};
+    }
+
+    is_color_used[index] = true;
+  }
+
   ColorOrder color_order;
 
   for (std::size_t i = 0; i < config.color_order.size(); ++i) {
     color_order.Set(config.color_order[i], i);
   }
 
-  Channel channel;
+  if (config.sort_workers == 0) {
+    throw std::invalid_argument{"At least one sorting worker is required"};
+  }
+
+  if (config.producers == 0) {
+    throw std::invalid_argument{"At least one producer is required"};
+  }
+
+  if (config.output_mode == OutputMode::kSummary && config.output_format != OutputFormat::kText) {
+    throw std::invalid_argument{"Summary output is supported by text format only"};
+  }
+
+  // Frames of generated and sorted colors would be indistinguishable from frames of two sequences.
+  if (config.output_mode == OutputMode::kFull && config.output_format != OutputFormat::kText) {
+    throw std::invalid_argument{"Full output is supported by text format only"};
+  }
+
+  if (!config.sort_file.empty() && config.sort_in_place == !config.sort_output.empty()) {
+    throw std::invalid_argument{"A sorted file is written either to another file or in place"};
+  }
+
+  if (!config.sort_file.empty()) {
+    detail::RunFileSort(config, color_order);
+    return;
+  }
+
+  Channel channel{kChannelCapacity};
+  ColorBufferPool color_buffers{kMaxPooledBuffers};
+  OutputQueue output{kOutputQueueCapacity};
+  TextBufferPool text_buffers{kMaxPooledBuffers};
   std::signal(SIGINT, ::proud_color_sorter::utils::detail::SignalHandler);
-  detail::ThreadExceptionHandle producer_exception_handle;
 
-  auto producer = std::thread([&channel, config, &producer_exception_handle]() mutable {
+  std::optional<detail::InputFile> input;
+
+  if (!config.input.empty()) {
+    input.emplace(config.input);
+  }
+
+  // With preserved order every sequence is sent on its own, otherwise text is gathered in large chunks.
+  const std::size_t chunk_size =
+      config.preserve_order ? 2 * (2 * config.generated_seq_max_size + kLineOverhead) : config.output_flush_size;
+
+  // Sorting workers may get at most `kOutputQueueCapacity` sequences ahead of the one the output thread waits for.
+  detail::ReorderWindow reorder_window{kOutputQueueCapacity};
+
+  detail::StageStats writer_stats;
+  detail::ThreadExceptionHandle writer_exception_handle;
+  std::thread writer{[&output, &text_buffers, preserve_order = config.preserve_order, &reorder_window,
+                      flush_size = config.output_flush_size, &stats = writer_stats, &writer_exception_handle]() {
     try {
-      detail::Produce(channel, config.generated_seq_max_size);
+      detail::WriteOutput(output, text_buffers, preserve_order, reorder_window, flush_size, stats);
+    } catch (const std::exception&) {
+      output.Cancel();
+      reorder_window.Close();
+      writer_exception_handle.Set(std::current_exception());
+    }
+  }};
+
+  // Sequences are either read by a single thread or generated by `config.producers` threads.
+  const std::size_t producer_count = input.has_value() ? 1 : config.producers;
+  detail::SequenceIds sequence_ids;
+  std::vector<detail::StageStats> producers_stats(producer_count);
+  std::vector<detail::ThreadExceptionHandle> producer_exception_handles(producer_count);
+  std::vector<std::thread> producers;
+  producers.reserve(producer_count);
+
+  if (input.has_value()) {
+    producers.emplace_back([&channel, &color_buffers, &sequence_ids, &reorder_window, &input, &config,
+                            &stats = producers_stats[0], &exception_handle = producer_exception_handles[0]]() {
+      try {
+        ColorReader reader{input->Get(), config.input_format};
+        detail::ReadInput(channel, color_buffers, reader, sequence_ids, reorder_window, stats);
+      } catch (const std::exception&) {
+        channel.Cancel();
+        reorder_window.Close();
+        exception_handle.Set(std::current_exception());
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < config.producers && !input.has_value(); ++i) {
+    producers.emplace_back([&channel, &color_buffers, &sequence_ids, &reorder_window,
+                            max_seq_length = config.generated_seq_max_size, color_generator = config.color_generator,
+                            &stats = producers_stats[i], &exception_handle = producer_exception_handles[i]]() {
+      try {
+        detail::Produce(channel, color_buffers, max_seq_length, color_generator, sequence_ids, reorder_window, stats);
+      } catch (const std::exception&) {
+        channel.Cancel();
+        reorder_window.Close();
+        exception_handle.Set(std::current_exception());
+      }
+    });
+  }
+
+  const auto consume = [&channel, &color_order, &config, &reorder_window, chunk_size, &output, &text_buffers,
+                        &color_buffers](detail::StageStats& stats, detail::ThreadExceptionHandle& exception_handle) {
+    try {
+      detail::Consume(channel, color_order, config.output_mode, config.output_format, config.preserve_order,
+                      reorder_window, chunk_size, output, text_buffers, color_buffers, stats);
     } catch (const std::exception&) {
       channel.Cancel();
-      producer_exception_handle.Set(std::current_exception());
+      reorder_window.Close();
+      exception_handle.Set(std::current_exception());
     }
-  });
+  };
 
-  try {
-    detail::Consume(channel, color_order);
-  } catch (const std::exception& error) {
-    channel.Cancel();
-    fmt::print(stderr, "Exception caught from consumer: {}.", error.what());
+  // The calling thread is a sorting worker too, so only `sort_workers - 1` threads are spawned.
+  std::vector<detail::StageStats> workers_stats(config.sort_workers);
+  std::vector<detail::ThreadExceptionHandle> worker_exception_handles(config.sort_workers);
+  std::vector<std::thread> workers;
+  workers.reserve(config.sort_workers - 1);
+
+  for (std::size_t i = 1; i < config.sort_workers; ++i) {
+    workers.emplace_back(consume, std::ref(workers_stats[i]), std::ref(worker_exception_handles[i]));
+  }
+
+  consume(workers_stats[0], worker_exception_handles[0]);
+
+  for (auto& worker : workers) {
+    worker.join();
   }
 
-  producer.join();
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  // All text is passed to the output thread, it exits once the queue is drained.
+  output.Close();
+  writer.join();
+
+  for (auto& exception_handle : worker_exception_handles) {
+    if (!exception_handle.IsEmpty()) {
+      fmt::print(stderr, "Exception caught from consumer: {}.\n", exception_handle.What());
+    }
+  }
 
-  if (!producer_exception_handle.IsEmpty()) {
-    fmt::print(stderr, "Exception caught from producer: {}.", producer_exception_handle.What());
+  for (auto& exception_handle : producer_exception_handles) {
+    if (!exception_handle.IsEmpty()) {
+      fmt::print(stderr, "Exception caught from producer: {}.\n", exception_handle.What());
+    }
   }
 
-  fmt::print("Threads are stopped.\n");
+  if (!writer_exception_handle.IsEmpty()) {
+    fmt::print(stderr, "Exception caught from writer: {}.\n", writer_exception_handle.What());
+  }
+
+  if (input.has_value()) {
+    detail::PrintStageStats("Read", "sequences", "colors", producers_stats);
+  } else {
+    detail::PrintProducerStats(producers_stats);
+    detail::PrintStageStats("Generate", "sequences", "colors", producers_stats);
+  }
+
+  detail::PrintStageStats("Sort", "sequences", "colors", workers_stats);
+  detail::PrintStageStats("Write", "chunks", "bytes", {writer_stats});
+  detail::PrintBufferPoolStats("Color buffer", color_buffers);
+  detail::PrintBufferPoolStats("Text buffer", text_buffers);
+
+  // Binary output must stay parseable, so the message goes to STDERR.
+  fmt::print(config.output_format == OutputFormat::kText ? stdout : stderr, "Threads are stopped.\n");
 }
 
-}  // namespace proud_color_sorter::utils
\ No newline at end of file
+}  // namespace proud_color_sorter::utils
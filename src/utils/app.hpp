@@ -2,14 +2,84 @@
 
 #include <array>
 #include <cstdint>
+#include <string>
 
 #include <color.hpp>
+#include <utils/color_reader.hpp>
 
 namespace proud_color_sorter::utils {
 
+/// Generator of random colors used by producers.
+enum class ColorGeneratorKind {
+  /// \c std::mt19937 with \c std::uniform_int_distribution, a draw per color.
+  kMersenneTwister,
+  /// xoshiro256** with 32 colors per draw, see \ref ColorGenerator.
+  kXoshiro,
+};
+
+/// What is printed for every sorted sequence.
+enum class OutputMode {
+  /// Generated and sorted colors.
+  kFull,
+  /// Sorted colors only.
+  kSorted,
+  /// Number of colors of each kind following the order.
+  kSummary,
+};
+
+/// How sequences are written to \c STDOUT.
+enum class OutputFormat {
+  /// Lines of \c R, \c G and \c B.
+  kText,
+  /// Binary frames with a byte per color, see \ref FrameHeader.
+  kBinary,
+  /// Binary frames with 2 bits per color, see \ref FrameHeader.
+  kPacked,
+};
+
 struct Config {
   std::array<Color, kColorSize> color_order{Color::kRed, Color::kGreen, Color::kBlue};
   std::size_t generated_seq_max_size = 0;
+
+  /// Path of a file to read sequences from instead of generating them, \c "-" stands for \c STDIN.
+  /// Empty means sequences are generated.
+  std::string input;
+
+  /// Layout of sequences in \ref input.
+  InputFormat input_format = InputFormat::kText;
+
+  /// Generator of random colors used by producers.
+  ColorGeneratorKind color_generator = ColorGeneratorKind::kMersenneTwister;
+
+  /// Number of threads generating sequences.
+  std::size_t producers = 1;
+
+  /// Number of threads sorting generated sequences.
+  std::size_t sort_workers = 1;
+
+  /// What is printed for every sorted sequence.
+  OutputMode output_mode = OutputMode::kFull;
+
+  /// How sequences are written, binary formats support \ref OutputMode::kSorted only.
+  OutputFormat output_format = OutputFormat::kText;
+
+  /// Output is gathered and written to \c STDOUT by chunks of at least this many bytes.
+  std::size_t output_flush_size = std::size_t{1} << 16;
+
+  /// Path of a file of raw color bytes to sort with memory mapping instead of running the pipeline.
+  std::string sort_file;
+
+  /// Path of a file to write colors of \ref sort_file to, required unless \ref sort_in_place is set.
+  std::string sort_output;
+
+  /// If \c true, \ref sort_file is overwritten with its sorted colors.
+  bool sort_in_place = false;
+
+  /// Number of threads sorting \ref sort_file, \c 0 means one per hardware thread.
+  std::size_t sort_file_threads = 0;
+
+  /// If \c true, sequences are printed in the order they were generated, regardless of which worker sorted them.
+  bool preserve_order = false;
 };
 
 void RunApp(const Config& config);
@@ -0,0 +1,221 @@
+#include <utils/color_reader.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <color_frame.hpp>
+
+namespace proud_color_sorter::utils {
+
+namespace detail {
+
+constexpr std::uint8_t kSkipChar = 0xFE;
+constexpr std::uint8_t kInvalidChar = 0xFF;
+
+/// Maps every byte of text input to the value of its color, \ref kSkipChar for separators or \ref kInvalidChar.
+constexpr std::array<std::uint8_t, 256> MakeTextTable() {
+  std::array<std::uint8_t, 256> table{};
+
+  for (auto& value : table) {
+    value = kInvalidChar;
+  }
+
+  table['R'] = static_cast<std::uint8_t>(Color::kRed);
+  table['G'] = static_cast<std::uint8_t>(Color::kGreen);
+  table['B'] = static_cast<std::uint8_t>(Color::kBlue);
+  table[' '] = kSkipChar;
+  table['\t'] = kSkipChar;
+  table['\r'] = kSkipChar;
+
+  return table;
+}
+
+constexpr auto kTextTable = MakeTextTable();
+
+}  // namespace detail
+
+ColorReader::ColorReader(const int fd, const InputFormat format, const std::size_t buffer_size)
+    : fd_(fd), format_(format), buffer_(std::max(buffer_size, kFrameHeaderSize)) {}
+
+bool ColorReader::ReadSequence(std::vector<Color>& colors) {
+  const bool is_read = format_ == InputFormat::kText ? ReadTextSequence(colors) : ReadBinarySequence(colors);
+
+  if (is_read) {
+    ++sequences_read_;
+  }
+
+  return is_read;
+}
+
+bool ColorReader::ReadTextSequence(std::vector<Color>& colors) {
+  std::size_t searched = 0;
+  const char* line_end = nullptr;
+
+  while ((line_end = static_cast<const char*>(
+              std::memchr(buffer_.data() + begin_ + searched, '\n', Buffered() - searched))) == nullptr) {
+    searched = Buffered();
+
+    if (!Refill()) {
+      if (Buffered() == 0) {
+        return false;
+      }
+
+      // The last line has no line break.
+      line_end = buffer_.data() + end_;
+      break;
+    }
+  }
+
+  const char* line = buffer_.data() + begin_;
+  const auto line_size = static_cast<std::size_t>(line_end - line);
+  colors.resize(line_size);
+  std::size_t size = 0;
+  bool is_separated = true;
+
+  for (std::size_t i = 0; i < line_size; ++i) {
+    const std::uint8_t value = detail::kTextTable[static_cast<unsigned char>(line[i])];
+
+    if (value == detail::kSkipChar) {
+      is_separated = true;
+      continue;
+    }
+
+    if (value == detail::kInvalidChar) {
+      throw std::runtime_error{"Invalid color '" + std::string{line[i]} + "' in sequence #" +
+                               std::to_string(sequences_read_)};
+    }
+
+    if (!is_separated) {
+      throw std::runtime_error{"Colors aren't separated in sequence #" + std::to_string(sequences_read_)};
+    }
+
+    colors[size++] = static_cast<Color>(value);
+    is_separated = false;
+  }
+
+  colors.resize(size);
+  begin_ = std::min(static_cast<std::size_t>(line_end - buffer_.data()) + 1, end_);
+
+  return true;
+}
+
+bool ColorReader::ReadBinarySequence(std::vector<Color>& colors) {
+  while (Buffered() < kFrameHeaderSize) {
+    if (!Refill()) {
+      if (Buffered() == 0) {
+        return false;
+      }
+
+      throw std::runtime_error{"Truncated header of sequence #" + std::to_string(sequences_read_)};
+    }
+  }
+
+  try {
+    const FrameHeader header = DecodeFrameHeader(buffer_.data() + begin_);
+    begin_ += kFrameHeaderSize;
+
+    // Plain payload is the colors themselves, so it is read in place and only validated.
+    if (header.is_packed) {
+      ReadResizing(payload_, FramePayloadSize(header.size, true));
+      colors.resize(header.size);
+      DecodeFramePayload(header, payload_.data(), colors.data());
+    } else {
+      ReadResizing(colors, header.size);
+      DecodeFramePayload(header, reinterpret_cast<const char*>(colors.data()), colors.data());
+    }
+  } catch (const std::system_error&) {
+    throw;
+  } catch (const std::runtime_error& error) {
+    throw std::runtime_error{std::string{error.what()} + " in sequence #" + std::to_string(sequences_read_)};
+  }
+
+  return true;
+}
+
+void ColorReader::ReadExactly(char* out, const std::size_t size) {
+  // Takes what is already buffered, the rest is read directly into \a out.
+  const std::size_t buffered = std::min(size, Buffered());
+
+  if (buffered > 0) {
+    std::memcpy(out, buffer_.data() + begin_, buffered);
+    begin_ += buffered;
+  }
+
+  for (std::size_t read = buffered; read < size;) {
+    const std::size_t chunk = ReadSome(out + read, size - read);
+
+    if (chunk == 0) {
+      throw std::runtime_error{"Truncated payload"};
+    }
+
+    read += chunk;
+  }
+}
+
+template <typename T>
+void ColorReader::ReadResizing(std::vector<T>& out, const std::size_t size) {
+  static_assert(sizeof(T) == 1);
+  out.resize(std::min(size, kMaxReadAhead));
+
+  // Capacity of \a out still grows geometrically, since resizing by a fixed step doesn't shrink it.
+  for (std::size_t read = 0;;) {
+    ReadExactly(reinterpret_cast<char*>(out.data()) + read, out.size() - read);
+    read = out.size();
+
+    if (read == size) {
+      return;
+    }
+
+    out.resize(std::min(size, read + kMaxReadAhead));
+  }
+}
+
+bool ColorReader::Refill() {
+  if (is_eof_) {
+    return false;
+  }
+
+  if (begin_ > 0) {
+    std::memmove(buffer_.data(), buffer_.data() + begin_, Buffered());
+    end_ -= begin_;
+    begin_ = 0;
+  }
+
+  if (end_ == buffer_.size()) {
+    buffer_.resize(buffer_.size() * 2);
+  }
+
+  const std::size_t read = ReadSome(buffer_.data() + end_, buffer_.size() - end_);
+
+  if (read == 0) {
+    is_eof_ = true;
+    return false;
+  }
+
+  end_ += read;
+
+  return true;
+}
+
+std::size_t ColorReader::ReadSome(char* out, const std::size_t size) {
+  while (true) {
+    const ::ssize_t read = ::read(fd_, out, size);
+
+    if (read >= 0) {
+      return static_cast<std::size_t>(read);
+    }
+
+    if (errno != EINTR) {
+      throw std::system_error{errno, std::generic_category(), "Failed to read input"};
+    }
+  }
+}
+
+}  // namespace proud_color_sorter::utils
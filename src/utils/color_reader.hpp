@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <color.hpp>
+
+namespace proud_color_sorter::utils {
+
+/// Layout of color sequences read by \ref ColorReader.
+enum class InputFormat {
+  /// One sequence per line, colors are \c R, \c G and \c B separated by spaces, e. g. `R G B`. Tabs and \c \\r are
+  /// separators too. Colors without a separator between them, e. g. `RGB`, are rejected.
+  kText,
+  /// Every sequence is a frame described by \ref FrameHeader, either plain or packed.
+  kBinary,
+};
+
+/// Reads color sequences from a file descriptor by large chunks.
+///
+/// Colors are parsed straight from the read buffer into the caller's sequence buffer. Large binary sequences bypass
+/// the read buffer and are read directly into the sequence, packed ones into a reused payload buffer.
+///
+/// Binary payload is read in chunks of at most \ref kMaxReadAhead bytes, so a corrupted frame size can't make the
+/// reader allocate much more than input actually holds.
+class ColorReader {
+ public:
+  static constexpr std::size_t kDefaultBufferSize = std::size_t{1} << 20;
+
+  /// Payload buffers are grown by at most this many bytes ahead of payload read so far.
+  static constexpr std::size_t kMaxReadAhead = std::size_t{1} << 24;
+
+  /// Creates a reader of file descriptor \a fd, which isn't owned by the reader.
+  ColorReader(int fd, InputFormat format, std::size_t buffer_size = kDefaultBufferSize);
+
+  /// Replaces contents of \a colors with the next sequence and returns \c true, returns \c false at the end of input.
+  /// Throws \c std::runtime_error if input is malformed and \c std::system_error if reading fails.
+  bool ReadSequence(std::vector<Color>& colors);
+
+  /// Returns the number of sequences read so far.
+  [[nodiscard]] std::size_t SequencesRead() const noexcept { return sequences_read_; }
+
+ private:
+  bool ReadTextSequence(std::vector<Color>& colors);
+  bool ReadBinarySequence(std::vector<Color>& colors);
+
+  /// Reads exactly \a size bytes to \a out, taking buffered bytes first.
+  /// Throws \c std::runtime_error if input ends earlier.
+  void ReadExactly(char* out, std::size_t size);
+
+  /// Replaces contents of \a out with exactly \a size bytes of input, growing it along with the input read, see
+  /// \ref kMaxReadAhead. Throws \c std::runtime_error if input ends earlier.
+  template <typename T>
+  void ReadResizing(std::vector<T>& out, std::size_t size);
+
+  /// Moves unread bytes to the front of the buffer and reads more, growing the buffer if it's full.
+  /// Returns \c false if nothing is read because input has ended.
+  bool Refill();
+
+  /// Reads up to \a size bytes to \a out, returns the number of bytes read, \c 0 at the end of input.
+  std::size_t ReadSome(char* out, std::size_t size);
+
+  [[nodiscard]] std::size_t Buffered() const noexcept { return end_ - begin_; }
+
+ private:
+  const int fd_;
+  const InputFormat format_;
+  std::vector<char> buffer_;
+  std::vector<char> payload_;
+  std::size_t begin_ = 0;
+  std::size_t end_ = 0;
+  bool is_eof_ = false;
+  std::size_t sequences_read_ = 0;
+};
+
+}  // namespace proud_color_sorter::utils
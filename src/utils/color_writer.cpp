@@ -0,0 +1,133 @@
+#include <utils/color_writer.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include <color_frame.hpp>
+
+namespace proud_color_sorter::utils {
+
+namespace detail {
+
+/// Text of every color followed by a separator, indexed by the color's underlying value.
+constexpr std::array<std::array<char, 2>, kColorSize> kColorText{{{'R', ' '}, {'G', ' '}, {'B', ' '}}};
+
+constexpr std::size_t kMaxNumberLength = std::numeric_limits<std::size_t>::digits10 + 1;
+
+}  // namespace detail
+
+ColorWriter::ColorWriter(const std::size_t capacity) : buffer_(capacity) {}
+
+ColorWriter::ColorWriter(TextBuffer buffer) : buffer_(std::move(buffer)) {
+  // Doesn't touch memory, chars aren't initialized.
+  buffer_.resize(buffer_.capacity());
+}
+
+void ColorWriter::AppendSequence(const std::string_view title, const Color* first, const Color* last) {
+  const auto size = static_cast<std::size_t>(last - first);
+  AppendHeader(title, size);
+
+  char* out = Reserve(detail::kColorText[0].size() * size + 2);
+
+  for (; first != last; ++first) {
+    std::memcpy(out, detail::kColorText[static_cast<std::size_t>(*first)].data(), detail::kColorText[0].size());
+    out += detail::kColorText[0].size();
+  }
+
+  // Keeps the layout of `fmt::join`: an empty sequence still gets its separator.
+  if (size == 0) {
+    *out++ = ' ';
+  }
+
+  *out++ = '\n';
+  size_ = static_cast<std::size_t>(out - buffer_.data());
+}
+
+void ColorWriter::AppendSummary(const std::string_view title, const SortedRuns& runs) {
+  AppendHeader(title, runs.Size());
+
+  char* out = Reserve((detail::kMaxNumberLength + 3) * kColorSize + 1);
+
+  for (const ColorRun& run : runs.GetRuns()) {
+    *out++ = detail::kColorText[static_cast<std::size_t>(run.color)][0];
+    *out++ = '=';
+    out = std::to_chars(out, out + detail::kMaxNumberLength, run.count).ptr;
+    *out++ = ' ';
+  }
+
+  *out++ = '\n';
+  size_ = static_cast<std::size_t>(out - buffer_.data());
+}
+
+void ColorWriter::AppendFrame(const Color* first, const Color* last, const bool is_packed) {
+  char* out = Reserve(FrameSize(static_cast<std::size_t>(last - first), is_packed));
+  out = EncodeFrame(first, last, is_packed, out);
+  size_ = static_cast<std::size_t>(out - buffer_.data());
+}
+
+void ColorWriter::Append(const std::string_view text) {
+  std::memcpy(Reserve(text.size()), text.data(), text.size());
+  size_ += text.size();
+}
+
+TextBuffer ColorWriter::ReleaseBuffer() noexcept {
+  TextBuffer buffer = std::move(buffer_);
+  buffer_.clear();
+  size_ = 0;
+  return buffer;
+}
+
+void ColorWriter::FlushTo(const int fd) {
+  WriteAll(fd, View());
+  Clear();
+}
+
+char* ColorWriter::Reserve(const std::size_t size) {
+  if (buffer_.size() - size_ < size) {
+    const std::size_t new_size = std::max(buffer_.size() * 2, size_ + size);
+
+    // Only buffered text is worth copying to new memory.
+    buffer_.resize(size_);
+    buffer_.resize(new_size);
+  }
+
+  return buffer_.data() + size_;
+}
+
+void ColorWriter::AppendHeader(const std::string_view title, const std::size_t size) {
+  constexpr std::string_view kSizePrefix = " (size=";
+  constexpr std::string_view kSizeSuffix = "): ";
+
+  char* out = Reserve(title.size() + kSizePrefix.size() + detail::kMaxNumberLength + kSizeSuffix.size());
+  out = std::copy(title.begin(), title.end(), out);
+  out = std::copy(kSizePrefix.begin(), kSizePrefix.end(), out);
+  out = std::to_chars(out, out + detail::kMaxNumberLength, size).ptr;
+  out = std::copy(kSizeSuffix.begin(), kSizeSuffix.end(), out);
+  size_ = static_cast<std::size_t>(out - buffer_.data());
+}
+
+void WriteAll(const int fd, std::string_view text) {
+  while (!text.empty()) {
+    const ::ssize_t written = ::write(fd, text.data(), text.size());
+
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      throw std::system_error{errno, std::generic_category(), "Failed to write output"};
+    }
+
+    text.remove_prefix(static_cast<std::size_t>(written));
+  }
+}
+
+}  // namespace proud_color_sorter::utils
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <color.hpp>
+#include <sorted_runs.hpp>
+
+namespace proud_color_sorter::utils {
+
+namespace detail {
+
+/// Allocator, which default-initializes elements constructed without arguments, so growing a \c std::vector of chars
+/// leaves new memory as is instead of zero-filling it.
+template <typename T>
+class DefaultInitAllocator : public std::allocator<T> {
+ public:
+  template <typename U>
+  struct rebind {  // NOLINT
+    using other = DefaultInitAllocator<U>;
+  };
+
+  DefaultInitAllocator() noexcept = default;
+
+  template <typename U>
+  DefaultInitAllocator(const DefaultInitAllocator<U>& /*other*/) noexcept {}  // NOLINT
+
+  template <typename U>
+  void construct(U* place) noexcept(noexcept(U())) {  // NOLINT
+    ::new (static_cast<void*>(place)) U;
+  }
+
+  template <typename U, typename... Args>
+  void construct(U* place, Args&&... args) {  // NOLINT
+    ::new (static_cast<void*>(place)) U(std::forward<Args>(args)...);
+  }
+};
+
+}  // namespace detail
+
+/// Text buffer, which isn't zero-filled when it's grown, since text is written over it anyway.
+using TextBuffer = std::vector<char, detail::DefaultInitAllocator<char>>;
+
+/// Formats color sequences as text or binary frames into a reusable buffer, which is written out with a single
+/// `write(2)`.
+///
+/// Colors are converted through a lookup table instead of a formatter call per color. Memory is allocated only while
+/// the buffer grows to its working size, \ref Clear keeps it. The buffer is a \ref TextBuffer, so neither taking
+/// over a recycled buffer nor growing it zero-fills memory, which is written over anyway.
+class ColorWriter {
+ public:
+  ColorWriter() = default;
+
+  /// Creates a writer, which has room for \a capacity bytes of text.
+  explicit ColorWriter(std::size_t capacity);
+
+  /// Creates a writer, which takes over memory of \a buffer. Contents of \a buffer are discarded.
+  explicit ColorWriter(TextBuffer buffer);
+
+  /// Appends line `<title> (size=N): C C C \n`, where \c C is \c R, \c G or \c B.
+  void AppendSequence(std::string_view title, const Color* first, const Color* last);
+
+  /// Appends line `<title> (size=N): C=n C=n C=n \n` with color counts of \a runs following their order.
+  void AppendSummary(std::string_view title, const SortedRuns& runs);
+
+  /// Appends colors from range [\a first, \a last) as a binary frame, see \ref FrameHeader.
+  void AppendFrame(const Color* first, const Color* last, bool is_packed);
+
+  /// Appends raw \a text.
+  void Append(std::string_view text);
+
+  /// Returns buffered text.
+  [[nodiscard]] std::string_view View() const noexcept { return {buffer_.data(), size_}; }
+
+  /// Returns the number of buffered bytes.
+  [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+  /// Returns \c true if nothing is buffered.
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  /// Drops buffered text, keeping the memory.
+  void Clear() noexcept { size_ = 0; }
+
+  /// Returns the underlying memory, e. g. to recycle it, and leaves the writer empty.
+  [[nodiscard]] TextBuffer ReleaseBuffer() noexcept;
+
+  /// Writes buffered text to file descriptor \a fd and clears the buffer.
+  /// Throws \c std::system_error if writing fails.
+  void FlushTo(int fd);
+
+ private:
+  /// Makes room for \a size more bytes and returns pointer to the end of buffered text.
+  char* Reserve(std::size_t size);
+
+  /// Appends `<title> (size=N): `.
+  void AppendHeader(std::string_view title, std::size_t size);
+
+ private:
+  TextBuffer buffer_;
+  std::size_t size_ = 0;
+};
+
+/// Writes the whole \a text to file descriptor \a fd, retrying after partial writes and interrupts.
+/// Throws \c std::system_error if writing fails.
+void WriteAll(int fd, std::string_view text);
+
+}  // namespace proud_color_sorter::utils
@@ -1,8 +1,10 @@
 #include <utils/daemon_main.hpp>
 
 #include <cstdlib>
+#include <map>
 #include <set>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <fmt/core.h>
@@ -52,6 +54,49 @@ int DaemonMain(int argc, const char* argv[]) {
   app.add_option("--color_order", color_order, "Color order. Possible values: 'r', 'g', 'b'.")
       ->expected(config.color_order.size())
       ->required();
+  app.add_option("--input", config.input, "Read sequences from a file instead of generating them, '-' for STDIN.");
+  app.add_option("--input_format", config.input_format, "Layout of input sequences. Possible values: 'text', 'binary'.")
+      ->default_str("text")
+      ->transform(CLI::CheckedTransformer(
+          std::map<std::string, InputFormat>{{"text", InputFormat::kText}, {"binary", InputFormat::kBinary}},
+          CLI::ignore_case));
+  app.add_option("--sort_file", config.sort_file,
+                 "Sort a file of raw color bytes (0 - red, 1 - green, 2 - blue) using all workers and exit.");
+  app.add_option("--sort_output", config.sort_output, "Write colors sorted by '--sort_file' here.");
+  app.add_flag("--sort_in_place", config.sort_in_place, "Overwrite '--sort_file' with its sorted colors.");
+  app.add_option("--sort_threads", config.sort_file_threads,
+                 "Number of threads sorting '--sort_file', 0 means one per hardware thread.")
+      ->default_val(config.sort_file_threads);
+  app.add_option("--generator", config.color_generator,
+                 "Random color generator. Possible values: 'mt19937', 'xoshiro'.")
+      ->default_str("mt19937")
+      ->transform(CLI::CheckedTransformer(
+          std::map<std::string, ColorGeneratorKind>{{"mt19937", ColorGeneratorKind::kMersenneTwister},
+                                                    {"xoshiro", ColorGeneratorKind::kXoshiro}},
+          CLI::ignore_case));
+  app.add_option("--producers", config.producers, "Number of threads generating color sequences.")
+      ->default_val(1)
+      ->check(CLI::PositiveNumber);
+  app.add_option("--workers", config.sort_workers, "Number of threads sorting generated sequences.")
+      ->default_val(1)
+      ->check(CLI::PositiveNumber);
+  app.add_flag("--preserve_order", config.preserve_order,
+               "Print sequences in the order they were generated when sorting on several workers.");
+  app.add_option("--output", config.output_mode, "What to print. Possible values: 'full', 'sorted', 'summary'.")
+      ->default_str("full")
+      ->transform(CLI::CheckedTransformer(std::map<std::string, OutputMode>{{"full", OutputMode::kFull},
+                                                                            {"sorted", OutputMode::kSorted},
+                                                                            {"summary", OutputMode::kSummary}},
+                                          CLI::ignore_case));
+  app.add_option("--output_format", config.output_format,
+                 "How sequences are printed. Possible values: 'text', 'binary', 'packed'.")
+      ->default_str("text")
+      ->transform(CLI::CheckedTransformer(std::map<std::string, OutputFormat>{{"text", OutputFormat::kText},
+                                                                              {"binary", OutputFormat::kBinary},
+                                                                              {"packed", OutputFormat::kPacked}},
+                                          CLI::ignore_case));
+  app.add_option("--flush_size", config.output_flush_size, "Output is written by chunks of at least this many bytes.")
+      ->default_val(config.output_flush_size);
   CLI11_PARSE(app, argc, argv);
 
   try {
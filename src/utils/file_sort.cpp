@@ -0,0 +1,76 @@
+#include <utils/file_sort.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+#include <utils/mapped_file.hpp>
+
+namespace proud_color_sorter::utils {
+
+namespace detail {
+
+/// Sorts mapped colors to \a out. Files aren't trusted, so colors are checked while they are counted: a byte, which
+/// isn't a color, would be counted out of histogram bounds.
+void SortMapped(const Color* first, const Color* last, Color* out, const ColorOrder& color_order,
+                const ParallelSortOptions& options) {
+  ParallelSortOptions checked_options = options;
+  checked_options.check_colors = true;
+  ParallelCountingSort(first, last, color_order, out, checked_options);
+}
+
+}  // namespace detail
+
+double FileSortStats::GigabytesPerSecond() const noexcept {
+  constexpr double kBytesPerGigabyte = 1e9;
+
+  return static_cast<double>(size) / kBytesPerGigabyte /
+         std::max(elapsed.count(), std::numeric_limits<double>::min());
+}
+
+FileSortStats SortFile(const std::string& input_path, const std::string& output_path, const ColorOrder& color_order,
+                       const ParallelSortOptions& options) {
+  const auto start = std::chrono::steady_clock::now();
+
+  if (output_path.empty()) {
+    throw std::invalid_argument{"Output path of a sorted file is empty"};
+  }
+
+  // Output, which is the input itself, would be truncated before the input is read.
+  if (std::filesystem::exists(output_path) && std::filesystem::equivalent(input_path, output_path)) {
+    throw std::invalid_argument{"Output '" + output_path + "' is the input file, sort it in place instead"};
+  }
+
+  const auto input = MappedFile::Open(input_path, MappedFile::Access::kReadOnly);
+  input.AdviseSequential();
+  const auto* colors = reinterpret_cast<const Color*>(input.Data());
+
+  const auto output = MappedFile::Create(output_path, input.Size());
+  output.AdviseSequential();
+
+  try {
+    detail::SortMapped(colors, colors + input.Size(), reinterpret_cast<Color*>(output.Data()), color_order, options);
+  } catch (const std::exception&) {
+    // Colors are checked before any is written, so the output holds nothing worth keeping.
+    std::error_code error;
+    std::filesystem::remove(output_path, error);
+    throw;
+  }
+
+  return {input.Size(), std::chrono::steady_clock::now() - start};
+}
+
+FileSortStats SortFileInPlace(const std::string& path, const ColorOrder& color_order,
+                              const ParallelSortOptions& options) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto file = MappedFile::Open(path, MappedFile::Access::kReadWrite);
+  file.AdviseSequential();
+  auto* colors = reinterpret_cast<Color*>(file.Data());
+  detail::SortMapped(colors, colors + file.Size(), colors, color_order, options);
+
+  return {file.Size(), std::chrono::steady_clock::now() - start};
+}
+
+}  // namespace proud_color_sorter::utils
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <counting_sort.hpp>
+#include <parallel_counting_sort.hpp>
+
+namespace proud_color_sorter::utils {
+
+/// Result of \ref SortFile.
+struct FileSortStats {
+  /// Number of sorted colors, i. e. bytes.
+  std::size_t size = 0;
+
+  /// Time spent on the whole sort: mapping files, counting and checking colors and writing them, page faults included.
+  std::chrono::duration<double> elapsed{0};
+
+  /// Returns throughput in gigabytes (10^9 bytes) per second.
+  [[nodiscard]] double GigabytesPerSecond() const noexcept;
+};
+
+/// Sorts colors of file \a input_path, which holds a byte per color equal to its value, using \a color_order.
+///
+/// Files are mapped to memory and sorted by \ref ParallelCountingSort. Sorted colors are written to \a output_path,
+/// which is created or truncated. Every byte of the input is checked to be a color while it's counted, before any color
+/// is written, and the output is removed if one isn't.
+/// Throws \c std::invalid_argument if \a output_path is empty or is the input itself, use \ref SortFileInPlace then.
+/// Throws \c std::runtime_error if the input holds a byte, which isn't a color.
+/// Throws \c std::system_error if files can't be opened or mapped.
+FileSortStats SortFile(const std::string& input_path, const std::string& output_path, const ColorOrder& color_order,
+                       const ParallelSortOptions& options = {});
+
+/// Sorts colors of file \a path in place, the same way as \ref SortFile does. The file is left untouched if it holds a
+/// byte, which isn't a color.
+FileSortStats SortFileInPlace(const std::string& path, const ColorOrder& color_order,
+                              const ParallelSortOptions& options = {});
+
+}  // namespace proud_color_sorter::utils
@@ -0,0 +1,92 @@
+#include <utils/mapped_file.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+namespace proud_color_sorter::utils {
+
+namespace detail {
+
+[[noreturn]] void ThrowSystemError(const std::string& what) {
+  throw std::system_error{errno, std::generic_category(), what};
+}
+
+}  // namespace detail
+
+MappedFile MappedFile::Open(const std::string& path, const Access access) {
+  const int fd = ::open(path.c_str(), access == Access::kReadOnly ? O_RDONLY : O_RDWR);
+
+  if (fd < 0) {
+    detail::ThrowSystemError("Failed to open '" + path + "'");
+  }
+
+  struct ::stat file_stat {};
+
+  if (::fstat(fd, &file_stat) != 0) {
+    const int error = errno;
+    ::close(fd);
+    errno = error;
+    detail::ThrowSystemError("Failed to stat '" + path + "'");
+  }
+
+  return MappedFile{fd, static_cast<std::size_t>(file_stat.st_size), access};
+}
+
+MappedFile MappedFile::Create(const std::string& path, const std::size_t size) {
+  constexpr ::mode_t kPermissions = 0644;
+
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, kPermissions);
+
+  if (fd < 0) {
+    detail::ThrowSystemError("Failed to create '" + path + "'");
+  }
+
+  if (::ftruncate(fd, static_cast<::off_t>(size)) != 0) {
+    const int error = errno;
+    ::close(fd);
+    errno = error;
+    detail::ThrowSystemError("Failed to resize '" + path + "'");
+  }
+
+  return MappedFile{fd, size, Access::kReadWrite};
+}
+
+MappedFile::MappedFile(const int fd, const std::size_t size, const Access access) : fd_(fd), size_(size) {
+  // `mmap` rejects empty mappings.
+  if (size_ == 0) {
+    return;
+  }
+
+  const int protection = access == Access::kReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+  void* data = ::mmap(nullptr, size_, protection, MAP_SHARED, fd_, 0);
+
+  if (data == MAP_FAILED) {
+    const int error = errno;
+    ::close(fd_);
+    errno = error;
+    detail::ThrowSystemError("Failed to map file");
+  }
+
+  data_ = static_cast<std::byte*>(data);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+
+  ::close(fd_);
+}
+
+void MappedFile::AdviseSequential() const noexcept {
+  if (data_ != nullptr) {
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+}
+
+}  // namespace proud_color_sorter::utils
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace proud_color_sorter::utils {
+
+/// File mapped to memory with `mmap`. Changes of a writable mapping are carried to the file.
+class MappedFile {
+ public:
+  enum class Access { kReadOnly, kReadWrite };
+
+  /// Maps the whole existing file at \a path. Throws \c std::system_error on failure.
+  static MappedFile Open(const std::string& path, Access access);
+
+  /// Creates a file of \a size bytes at \a path, or truncates the existing one, and maps it for writing.
+  /// Throws \c std::system_error on failure.
+  static MappedFile Create(const std::string& path, std::size_t size);
+
+  MappedFile(const MappedFile& other) = delete;
+
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  ~MappedFile();
+
+  /// Returns the mapped bytes, \c nullptr for an empty file.
+  [[nodiscard]] std::byte* Data() const noexcept { return data_; }
+
+  /// Returns the size of the file in bytes.
+  [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+  /// Hints the kernel that the mapping is accessed sequentially, so pages are read ahead aggressively.
+  void AdviseSequential() const noexcept;
+
+ private:
+  MappedFile(int fd, std::size_t size, Access access);
+
+ private:
+  int fd_ = -1;
+  std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace proud_color_sorter::utils
@@ -1,18 +1,22 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <limits>
 #include <random>
 #include <type_traits>
 
+#include <color.hpp>
+
 namespace proud_color_sorter::utils {
 
 template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
 class RandomGenerator {
  public:
   RandomGenerator(T min_value, T max_value)
-      : uniform_distribution_(min_value, max_value), mersenne_twister_(rand_device_()) {}
+      : mersenne_twister_(rand_device_()), uniform_distribution_(min_value, max_value) {}
 
-  T Generate() { return uniform_distribution_(mersenne_twister_); }
+  T Generate() { return static_cast<T>(uniform_distribution_(mersenne_twister_)); }
 
  private:
   std::random_device rand_device_;
@@ -20,4 +24,130 @@ class RandomGenerator {
   std::uniform_int_distribution<std::size_t> uniform_distribution_;
 };
 
-}  // namespace proud_color_sorter::utils
\ No newline at end of file
+/// xoshiro256** pseudo random number generator by D. Blackman and S. Vigna, see https://prng.di.unimi.it.
+/// Satisfies `UniformRandomBitGenerator` requirements.
+class Xoshiro256StarStar {
+ public:
+  using result_type = std::uint64_t;  // NOLINT
+
+  /// Expands \a seed to the whole state with splitmix64, as recommended by the authors.
+  explicit Xoshiro256StarStar(std::uint64_t seed) noexcept {
+    for (auto& word : state_) {
+      seed += 0x9E3779B97F4A7C15ULL;
+      std::uint64_t mixed = seed;
+      mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+      word = mixed ^ (mixed >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }  // NOLINT
+
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }  // NOLINT
+
+  result_type operator()() noexcept {
+    const std::uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+    const std::uint64_t shifted = state_[1] << 17;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= shifted;
+    state_[3] = RotateLeft(state_[3], 45);
+
+    return result;
+  }
+
+ private:
+  static constexpr std::uint64_t RotateLeft(const std::uint64_t value, const int shift) noexcept {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+ private:
+  std::array<std::uint64_t, 4> state_{};
+};
+
+/// Generates uniformly distributed colors in bulk.
+///
+/// Every 64-bit output of \ref Xoshiro256StarStar is mapped to `[0, 3^32)` with Lemire's multiply-shift reduction,
+/// rejecting the few biased outputs, and split into 32 base-3 digits, i. e. 32 colors.
+class ColorGenerator {
+ public:
+  static_assert(kColorSize == 3, "Colors are extracted as base-3 digits");
+
+  /// Number of colors derived from a single 64-bit random number.
+  static constexpr std::size_t kColorsPerDraw = 32;
+
+  /// Seeds the generator with \c std::random_device.
+  ColorGenerator() : engine_(SeedFromDevice()) {}
+
+  explicit ColorGenerator(const std::uint64_t seed) : engine_(seed) {}
+
+  /// Fills range [\a first, \a last) with random colors.
+  void Generate(Color* first, Color* last) noexcept {
+    while (static_cast<std::size_t>(last - first) >= kColorsPerDraw) {
+      SplitToColors(Draw(), first, kColorsPerDraw);
+      first += kColorsPerDraw;
+    }
+
+    SplitToColors(Draw(), first, static_cast<std::size_t>(last - first));
+  }
+
+ private:
+  /// 3^32, the largest power of three with a negligible rejection rate (~1e-4) of 64-bit numbers.
+  static constexpr std::uint64_t kRange = 1853020188851841ULL;
+
+  static std::uint64_t SeedFromDevice() {
+    std::random_device rand_device;
+    return (static_cast<std::uint64_t>(rand_device()) << 32) | rand_device();
+  }
+
+  /// Returns high 64 bits of `lhs * rhs` and stores low ones to \a low.
+  static std::uint64_t MultiplyHigh(const std::uint64_t lhs, const std::uint64_t rhs, std::uint64_t& low) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using Uint128 = unsigned __int128;
+    const Uint128 product = static_cast<Uint128>(lhs) * rhs;
+    low = static_cast<std::uint64_t>(product);
+    return static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t lhs_low = lhs & 0xFFFFFFFFULL;
+    const std::uint64_t lhs_high = lhs >> 32;
+    const std::uint64_t rhs_low = rhs & 0xFFFFFFFFULL;
+    const std::uint64_t rhs_high = rhs >> 32;
+    const std::uint64_t low_low = lhs_low * rhs_low;
+    const std::uint64_t middle = lhs_high * rhs_low + (low_low >> 32);
+    const std::uint64_t middle_carry = lhs_low * rhs_high + (middle & 0xFFFFFFFFULL);
+    low = lhs * rhs;
+    return lhs_high * rhs_high + (middle >> 32) + (middle_carry >> 32);
+#endif
+  }
+
+  /// Returns a uniformly distributed number in `[0, kRange)`.
+  std::uint64_t Draw() noexcept {
+    std::uint64_t low = 0;
+    std::uint64_t high = MultiplyHigh(engine_(), kRange, low);
+
+    if (low < kRange) {
+      constexpr std::uint64_t kThreshold = (0 - kRange) % kRange;
+
+      while (low < kThreshold) {
+        high = MultiplyHigh(engine_(), kRange, low);
+      }
+    }
+
+    return high;
+  }
+
+  static void SplitToColors(std::uint64_t value, Color* out, const std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = static_cast<Color>(value % kColorSize);
+      value /= kColorSize;
+    }
+  }
+
+ private:
+  Xoshiro256StarStar engine_;
+};
+
+}  // namespace proud_color_sorter::utils
@@ -0,0 +1,144 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <buffer_pool.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(BufferPoolTests, acquire_from_empty_pool_allocates) {
+  BufferPool<int> pool{4};
+
+  const auto buffer = pool.Acquire(16);
+  ASSERT_TRUE(buffer.empty());
+  ASSERT_GE(buffer.capacity(), 16);
+
+  const auto stats = pool.GetStats();
+  ASSERT_EQ(stats.acquisitions, 1);
+  ASSERT_EQ(stats.allocations, 1);
+}
+
+TEST(BufferPoolTests, released_buffer_is_reused) {
+  BufferPool<int> pool{4};
+
+  auto buffer = pool.Acquire(16);
+  buffer.assign(16, 1);
+  const int* data = buffer.data();
+  pool.Release(std::move(buffer));
+
+  const auto reused = pool.Acquire(16);
+  ASSERT_TRUE(reused.empty());
+  ASSERT_EQ(reused.data(), data);
+
+  const auto stats = pool.GetStats();
+  ASSERT_EQ(stats.acquisitions, 2);
+  ASSERT_EQ(stats.allocations, 1);
+  ASSERT_EQ(stats.releases, 1);
+  ASSERT_EQ(stats.drops, 0);
+}
+
+TEST(BufferPoolTests, too_small_buffer_is_grown) {
+  BufferPool<int> pool{4};
+
+  pool.Release(pool.Acquire(8));
+  const auto buffer = pool.Acquire(32);
+  ASSERT_GE(buffer.capacity(), 32);
+  ASSERT_EQ(pool.GetStats().allocations, 2);
+}
+
+TEST(BufferPoolTests, buffer_grown_by_caller_is_counted_on_release) {
+  BufferPool<int> pool{4};
+
+  auto buffer = pool.Acquire(0);
+  buffer.assign(100, 1);
+  pool.Release(std::move(buffer));
+  ASSERT_EQ(pool.GetStats().allocations, 1);
+
+  // The grown buffer is reused as is and is big enough, so nothing is allocated.
+  buffer = pool.Acquire(0);
+  buffer.assign(100, 1);
+  pool.Release(std::move(buffer));
+  ASSERT_EQ(pool.GetStats().allocations, 1);
+
+  buffer = pool.Acquire(0);
+  buffer.assign(buffer.capacity() + 1, 1);
+  pool.Release(std::move(buffer));
+  ASSERT_EQ(pool.GetStats().allocations, 2);
+}
+
+TEST(BufferPoolTests, foreign_buffer_is_counted_on_release) {
+  BufferPool<int> pool{4};
+
+  pool.Release(std::vector<int>(8));
+  pool.Release(std::vector<int>{});
+
+  const auto stats = pool.GetStats();
+  ASSERT_EQ(stats.allocations, 1);
+  ASSERT_EQ(stats.drops, 1);
+}
+
+TEST(BufferPoolTests, buffers_over_limit_are_dropped) {
+  BufferPool<int> pool{1};
+
+  auto first = pool.Acquire(8);
+  auto second = pool.Acquire(8);
+  pool.Release(std::move(first));
+  pool.Release(std::move(second));
+
+  const auto stats = pool.GetStats();
+  ASSERT_EQ(stats.releases, 2);
+  ASSERT_EQ(stats.drops, 1);
+}
+
+TEST(BufferPoolTests, steady_state_loop_does_not_allocate) {
+  constexpr std::size_t kInFlight = 8;
+  constexpr std::size_t kIterations = 10'000;
+  BufferPool<int> pool{kInFlight};
+
+  std::vector<std::vector<int>> in_flight;
+
+  for (std::size_t i = 0; i < kIterations; ++i) {
+    in_flight.emplace_back(pool.Acquire(64));
+
+    if (in_flight.size() == kInFlight) {
+      for (auto& buffer : in_flight) {
+        pool.Release(std::move(buffer));
+      }
+
+      in_flight.clear();
+    }
+  }
+
+  ASSERT_EQ(pool.GetStats().allocations, kInFlight);
+}
+
+TEST(BufferPoolTests, concurrent_acquire_and_release) {
+  constexpr std::size_t kThreads = 4;
+  constexpr std::size_t kIterations = 10'000;
+  BufferPool<int> pool{kThreads};
+
+  std::vector<std::thread> threads;
+
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&pool]() {
+      for (std::size_t j = 0; j < kIterations; ++j) {
+        auto buffer = pool.Acquire(16);
+        buffer.push_back(1);
+        pool.Release(std::move(buffer));
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = pool.GetStats();
+  ASSERT_EQ(stats.acquisitions, kThreads * kIterations);
+  ASSERT_EQ(stats.releases, kThreads * kIterations);
+  ASSERT_LE(stats.allocations, kThreads);
+  ASSERT_EQ(stats.drops, 0);
+}
+
+}  // namespace proud_color_sorter::tests
@@ -0,0 +1,158 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_frame.hpp>
+#include <color_samples.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+std::string Encode(const std::vector<Color>& colors, const bool is_packed) {
+  std::string frame(FrameSize(colors.size(), is_packed), '\0');
+  const char* end = EncodeFrame(colors.data(), colors.data() + colors.size(), is_packed, frame.data());
+  EXPECT_EQ(end, frame.data() + frame.size());
+  return frame;
+}
+
+std::vector<Color> Decode(const std::string& frame) {
+  const FrameHeader header = DecodeFrameHeader(frame.data());
+  EXPECT_EQ(frame.size(), FrameSize(header.size, header.is_packed));
+  std::vector<Color> colors(header.size);
+  DecodeFramePayload(header, frame.data() + kFrameHeaderSize, colors.data());
+  return colors;
+}
+
+/// Recomputes the checksum of a modified \a frame.
+void UpdateChecksum(std::string& frame) {
+  const std::uint32_t checksum = Crc32c(frame.data() + kFrameHeaderSize, frame.size() - kFrameHeaderSize);
+
+  for (std::size_t i = 0; i < sizeof(checksum); ++i) {
+    frame[8 + i] = static_cast<char>((checksum >> (8 * i)) & 0xFF);
+  }
+}
+
+}  // namespace
+
+TEST(ColorFrameTests, crc32c_check_value) {
+  const std::string data = "123456789";
+
+  ASSERT_EQ(Crc32c(data.data(), data.size()), 0xE3069283U);
+  ASSERT_EQ(Crc32c(data.data(), 0), 0U);
+}
+
+TEST(ColorFrameTests, crc32c_scalar_matches_check_value) {
+  const std::string data = "123456789";
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+
+  ASSERT_EQ(~detail::Crc32cScalar(~0U, bytes, data.size()), 0xE3069283U);
+  ASSERT_EQ(detail::Crc32cScalar(0, bytes, 0), 0U);
+}
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+
+TEST(ColorFrameTests, crc32c_sse42_matches_scalar) {
+  if (!__builtin_cpu_supports("sse4.2")) {
+    GTEST_SKIP() << "CPU doesn't support SSE4.2";
+  }
+
+  std::string data;
+
+  for (std::size_t i = 0; i < 1000; ++i) {
+    data.push_back(static_cast<char>(i * 31 % 251));
+  }
+
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+
+  // Sizes cover both the 8-byte steps and the tail.
+  const std::vector<std::size_t> sizes{0, 1, 7, 8, 9, 63, data.size()};
+
+  for (const std::size_t size : sizes) {
+    ASSERT_EQ(detail::Crc32cSse42(~0U, bytes, size), detail::Crc32cScalar(~0U, bytes, size)) << size;
+  }
+}
+
+#endif
+
+TEST(ColorFrameTests, header_layout) {
+  const std::vector<Color> colors{Color::kRed, Color::kGreen, Color::kBlue, Color::kGreen, Color::kBlue};
+  const std::string frame = Encode(colors, true);
+
+  ASSERT_EQ(frame.size(), kFrameHeaderSize + 2);
+  ASSERT_EQ(frame.substr(0, 2), "PC");
+  ASSERT_EQ(static_cast<std::uint8_t>(frame[2]), kFrameVersion);
+  ASSERT_EQ(static_cast<std::uint8_t>(frame[3]), kFramePackedFlag);
+  ASSERT_EQ(frame.substr(4, 4), std::string("\x05\0\0\0", 4));
+  // R | G << 2 | B << 4 | G << 6, then B.
+  ASSERT_EQ(static_cast<std::uint8_t>(frame[12]), 0b01100100);
+  ASSERT_EQ(static_cast<std::uint8_t>(frame[13]), 0b10);
+
+  const FrameHeader header = DecodeFrameHeader(frame.data());
+  ASSERT_EQ(header.version, kFrameVersion);
+  ASSERT_TRUE(header.is_packed);
+  ASSERT_EQ(header.size, colors.size());
+}
+
+TEST(ColorFrameTests, round_trip) {
+  for (const bool is_packed : {false, true}) {
+    for (const std::size_t size : std::vector<std::size_t>{0, 1, 3, 4, 7, 8, 9, 31, 32, 33, 1000, 100003}) {
+      const auto colors = samples::GenerateColors(size);
+
+      ASSERT_EQ(Decode(Encode(colors, is_packed)), colors) << "size=" << size << ", packed=" << is_packed;
+    }
+  }
+}
+
+TEST(ColorFrameTests, decode_plain_in_place) {
+  const auto colors = samples::GenerateColors(100);
+  std::string frame = Encode(colors, false);
+  const FrameHeader header = DecodeFrameHeader(frame.data());
+  char* payload = frame.data() + kFrameHeaderSize;
+
+  DecodeFramePayload(header, payload, reinterpret_cast<Color*>(payload));
+
+  ASSERT_EQ(std::vector<Color>(reinterpret_cast<Color*>(payload), reinterpret_cast<Color*>(payload) + colors.size()),
+            colors);
+}
+
+TEST(ColorFrameTests, invalid_header_throws) {
+  const std::string frame = Encode(samples::GenerateColors(10), false);
+
+  for (std::size_t position = 0; position < 4; ++position) {
+    std::string corrupted = frame;
+    corrupted[position] = static_cast<char>(corrupted[position] ^ 0x10);
+
+    ASSERT_THROW(DecodeFrameHeader(corrupted.data()), std::runtime_error) << "position=" << position;
+  }
+}
+
+TEST(ColorFrameTests, corrupted_payload_throws) {
+  for (const bool is_packed : {false, true}) {
+    std::string frame = Encode(samples::GenerateColors(1000), is_packed);
+    frame[kFrameHeaderSize + 100] = static_cast<char>(frame[kFrameHeaderSize + 100] ^ 0x01);
+
+    ASSERT_THROW(Decode(frame), std::runtime_error) << "packed=" << is_packed;
+  }
+}
+
+TEST(ColorFrameTests, invalid_color_throws) {
+  for (const bool is_packed : {false, true}) {
+    std::string frame = Encode(samples::GenerateColors(9), is_packed);
+    frame.back() = static_cast<char>(is_packed ? 0b11 : kColorSize);
+    UpdateChecksum(frame);
+
+    ASSERT_THROW(Decode(frame), std::runtime_error) << "packed=" << is_packed;
+  }
+
+  std::string frame = Encode(samples::GenerateColors(16), true);
+  frame[kFrameHeaderSize + 1] = static_cast<char>(0b11000000);
+  UpdateChecksum(frame);
+
+  ASSERT_THROW(Decode(frame), std::runtime_error);
+}
+
+}  // namespace proud_color_sorter::tests
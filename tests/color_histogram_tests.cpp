@@ -0,0 +1,109 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color.hpp>
+#include <color_histogram.hpp>
+#include <color_samples.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+using CountColors = ColorHistogram (*)(const Color*, const Color*) noexcept;
+
+void ExpectMatchesScalar(const CountColors count_colors) {
+  // Sizes around vector widths and the per-byte counters widening period.
+  const std::vector<std::size_t> sizes{1, 15, 16, 17, 31, 32, 33, 100, 255 * 16 + 3, 255 * 32, 255 * 32 + 1, 100'000};
+
+  for (const std::size_t size : sizes) {
+    auto colors = samples::GenerateColors(size);
+    const Color* first = colors.data();
+    const Color* last = colors.data() + colors.size();
+
+    EXPECT_EQ(count_colors(first, last), CountColorsScalar(first, last)) << "size: " << size;
+  }
+}
+
+void ExpectSingleColorDoesNotOverflow(const CountColors count_colors) {
+  std::vector<Color> colors(1'000'000, Color::kGreen);
+
+  auto histogram = count_colors(colors.data(), colors.data() + colors.size());
+
+  EXPECT_EQ(histogram[static_cast<std::size_t>(Color::kRed)], 0);
+  EXPECT_EQ(histogram[static_cast<std::size_t>(Color::kGreen)], colors.size());
+  EXPECT_EQ(histogram[static_cast<std::size_t>(Color::kBlue)], 0);
+}
+
+}  // namespace
+
+TEST(ColorHistogramTests, empty_range) {
+  std::vector<Color> colors;
+
+  EXPECT_EQ(CountColorsScalar(colors.data(), colors.data()), ColorHistogram{});
+  EXPECT_EQ(CountColorsSimd(colors.data(), colors.data()), ColorHistogram{});
+}
+
+TEST(ColorHistogramTests, scalar_counts) {
+  std::vector<Color> colors{Color::kRed, Color::kBlue, Color::kBlue, Color::kGreen, Color::kBlue};
+
+  auto histogram = CountColorsScalar(colors.data(), colors.data() + colors.size());
+
+  EXPECT_EQ(histogram[static_cast<std::size_t>(Color::kRed)], 1);
+  EXPECT_EQ(histogram[static_cast<std::size_t>(Color::kGreen)], 1);
+  EXPECT_EQ(histogram[static_cast<std::size_t>(Color::kBlue)], 3);
+}
+
+TEST(ColorHistogramTests, simd_matches_scalar_on_random_input) {
+  ExpectMatchesScalar(CountColorsSimd);
+}
+
+TEST(ColorHistogramTests, simd_single_color_does_not_overflow) {
+  ExpectSingleColorDoesNotOverflow(CountColorsSimd);
+}
+
+TEST(ColorHistogramTests, checked_matches_simd_on_valid_input) {
+  // Spans several checked blocks and ends with a partial one.
+  auto colors = samples::GenerateColors(100'003);
+
+  const auto histogram = CountColorsChecked(colors.data(), colors.data() + colors.size());
+
+  ASSERT_TRUE(histogram.has_value());
+  EXPECT_EQ(*histogram, CountColorsSimd(colors.data(), colors.data() + colors.size()));
+  EXPECT_EQ(CountColorsChecked(colors.data(), colors.data()), ColorHistogram{});
+}
+
+TEST(ColorHistogramTests, checked_rejects_invalid_bytes) {
+  auto colors = samples::GenerateColors(100'003);
+
+  for (const std::size_t index : {std::size_t{0}, std::size_t{50'000}, colors.size() - 1}) {
+    const Color color = colors[index];
+    colors[index] = static_cast<Color>(0xFF);
+    EXPECT_FALSE(CountColorsChecked(colors.data(), colors.data() + colors.size()).has_value()) << index;
+    colors[index] = color;
+  }
+}
+
+#ifdef PROUD_COLOR_SORTER_X86_KERNELS
+
+TEST(ColorHistogramTests, sse2_matches_scalar) {
+  if (!__builtin_cpu_supports("sse2")) {
+    GTEST_SKIP() << "CPU doesn't support SSE2";
+  }
+
+  ExpectMatchesScalar(detail::CountColorsSse2);
+  ExpectSingleColorDoesNotOverflow(detail::CountColorsSse2);
+}
+
+TEST(ColorHistogramTests, avx2_matches_scalar) {
+  if (!__builtin_cpu_supports("avx2")) {
+    GTEST_SKIP() << "CPU doesn't support AVX2";
+  }
+
+  ExpectMatchesScalar(detail::CountColorsAvx2);
+  ExpectSingleColorDoesNotOverflow(detail::CountColorsAvx2);
+}
+
+#endif
+
+}  // namespace proud_color_sorter::tests
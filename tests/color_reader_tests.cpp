@@ -0,0 +1,200 @@
+#include <unistd.h>
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_frame.hpp>
+#include <utils/color_reader.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+/// Temporary file filled with \a content, removed once closed.
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string& content) : file_(std::tmpfile(), &std::fclose) {
+    std::fwrite(content.data(), 1, content.size(), file_.get());
+    std::fflush(file_.get());
+    std::rewind(file_.get());
+  }
+
+  [[nodiscard]] int Fd() const { return fileno(file_.get()); }
+
+ private:
+  std::unique_ptr<std::FILE, decltype(&std::fclose)> file_;
+};
+
+std::vector<std::vector<Color>> ReadAll(utils::ColorReader& reader) {
+  std::vector<std::vector<Color>> sequences;
+  std::vector<Color> colors;
+
+  while (reader.ReadSequence(colors)) {
+    sequences.push_back(colors);
+  }
+
+  return sequences;
+}
+
+std::string EncodeBinary(const std::vector<std::vector<Color>>& sequences, const bool is_packed = false) {
+  std::string encoded;
+
+  for (const auto& sequence : sequences) {
+    const std::size_t offset = encoded.size();
+    encoded.resize(offset + FrameSize(sequence.size(), is_packed));
+    EncodeFrame(sequence.data(), sequence.data() + sequence.size(), is_packed, encoded.data() + offset);
+  }
+
+  return encoded;
+}
+
+}  // namespace
+
+TEST(ColorReaderTests, read_text) {
+  const TemporaryFile file{"R G B\nB B R G\n\nG\r\nB R"};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kText};
+
+  const std::vector<std::vector<Color>> expected{
+      {Color::kRed, Color::kGreen, Color::kBlue},
+      {Color::kBlue, Color::kBlue, Color::kRed, Color::kGreen},
+      {},
+      {Color::kGreen},
+      {Color::kBlue, Color::kRed},
+  };
+
+  ASSERT_EQ(ReadAll(reader), expected);
+  ASSERT_EQ(reader.SequencesRead(), expected.size());
+}
+
+TEST(ColorReaderTests, read_empty_input) {
+  const TemporaryFile file{""};
+  utils::ColorReader text_reader{file.Fd(), utils::InputFormat::kText};
+  utils::ColorReader binary_reader{file.Fd(), utils::InputFormat::kBinary};
+
+  ASSERT_TRUE(ReadAll(text_reader).empty());
+  ASSERT_TRUE(ReadAll(binary_reader).empty());
+}
+
+TEST(ColorReaderTests, text_lines_longer_than_buffer) {
+  std::vector<std::vector<Color>> expected;
+  std::string content;
+
+  for (std::size_t size = 0; size < 100; ++size) {
+    expected.emplace_back();
+
+    for (std::size_t i = 0; i < size; ++i) {
+      const auto color = static_cast<Color>((size + i) % kColorSize);
+      expected.back().push_back(color);
+      content += "RGB"[static_cast<std::size_t>(color)];
+      content += ' ';
+    }
+
+    content += '\n';
+  }
+
+  const TemporaryFile file{content};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kText, 8};
+
+  ASSERT_EQ(ReadAll(reader), expected);
+}
+
+TEST(ColorReaderTests, invalid_text_throws) {
+  const TemporaryFile file{"R G\nR X B\n"};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kText};
+  std::vector<Color> colors;
+
+  ASSERT_TRUE(reader.ReadSequence(colors));
+  ASSERT_THROW(reader.ReadSequence(colors), std::runtime_error);
+}
+
+TEST(ColorReaderTests, unseparated_colors_throw) {
+  const TemporaryFile file{"R\tG\r\nRGB\n"};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kText};
+  std::vector<Color> colors;
+
+  ASSERT_TRUE(reader.ReadSequence(colors));
+  ASSERT_EQ(colors, (std::vector<Color>{Color::kRed, Color::kGreen}));
+  ASSERT_THROW(reader.ReadSequence(colors), std::runtime_error);
+}
+
+TEST(ColorReaderTests, read_binary) {
+  const std::vector<std::vector<Color>> expected{
+      {Color::kRed, Color::kGreen, Color::kBlue},
+      {},
+      std::vector<Color>(1000, Color::kBlue),
+      {Color::kGreen},
+  };
+  const TemporaryFile file{EncodeBinary(expected)};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kBinary, 16};
+
+  ASSERT_EQ(ReadAll(reader), expected);
+}
+
+TEST(ColorReaderTests, read_packed_binary) {
+  const std::vector<std::vector<Color>> expected{
+      {Color::kRed, Color::kGreen, Color::kBlue},
+      {},
+      std::vector<Color>(1001, Color::kBlue),
+      {Color::kGreen, Color::kGreen, Color::kRed, Color::kBlue, Color::kRed},
+  };
+  const TemporaryFile file{EncodeBinary(expected, true)};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kBinary, 16};
+
+  ASSERT_EQ(ReadAll(reader), expected);
+}
+
+TEST(ColorReaderTests, truncated_binary_throws) {
+  auto encoded = EncodeBinary({{Color::kRed, Color::kGreen, Color::kBlue}});
+  encoded.pop_back();
+  const TemporaryFile file{encoded};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kBinary};
+  std::vector<Color> colors;
+
+  ASSERT_THROW(reader.ReadSequence(colors), std::runtime_error);
+}
+
+TEST(ColorReaderTests, payload_longer_than_read_ahead) {
+  const std::vector<std::vector<Color>> expected{
+      std::vector<Color>(utils::ColorReader::kMaxReadAhead * 2 + 3, Color::kGreen),
+      {Color::kRed},
+  };
+  const TemporaryFile file{EncodeBinary(expected)};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kBinary};
+
+  ASSERT_EQ(ReadAll(reader), expected);
+}
+
+TEST(ColorReaderTests, oversized_header_does_not_allocate_its_size) {
+  for (const bool is_packed : {false, true}) {
+    auto encoded = EncodeBinary({{Color::kRed, Color::kGreen, Color::kBlue}}, is_packed);
+
+    // Claims 4G colors, while input holds only a few bytes of payload.
+    for (std::size_t i = 4; i < 8; ++i) {
+      encoded[i] = static_cast<char>(0xFF);
+    }
+
+    const TemporaryFile file{encoded};
+    utils::ColorReader reader{file.Fd(), utils::InputFormat::kBinary};
+    std::vector<Color> colors;
+
+    ASSERT_THROW(reader.ReadSequence(colors), std::runtime_error);
+    ASSERT_LE(colors.capacity(), utils::ColorReader::kMaxReadAhead);
+  }
+}
+
+TEST(ColorReaderTests, corrupted_binary_throws) {
+  auto encoded = EncodeBinary({{Color::kRed, Color::kGreen}});
+  encoded.back() = static_cast<char>(Color::kBlue);
+  const TemporaryFile file{encoded};
+  utils::ColorReader reader{file.Fd(), utils::InputFormat::kBinary};
+  std::vector<Color> colors;
+
+  ASSERT_THROW(reader.ReadSequence(colors), std::runtime_error);
+}
+
+}  // namespace proud_color_sorter::tests
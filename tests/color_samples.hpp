@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <color.hpp>
+#include <counting_sort.hpp>
+#include <utils/random_generator.hpp>
+
+/// Sample colors and orders shared by tests and benchmarks.
+namespace proud_color_sorter::samples {
+
+/// Returns \a size uniformly distributed colors. Generator is seeded with \a size, so runs are reproducible.
+inline std::vector<Color> GenerateColors(const std::size_t size) {
+  utils::ColorGenerator color_generator{size};
+  std::vector<Color> colors(size);
+  color_generator.Generate(colors.data(), colors.data() + colors.size());
+  return colors;
+}
+
+/// Returns the order, in which \a first color goes first, \a second goes second and \a third goes last.
+template <typename OrderType = ColorOrder>
+constexpr OrderType MakeOrder(const Color first = Color::kBlue, const Color second = Color::kRed,
+                              const Color third = Color::kGreen) {
+  OrderType order;
+  order.Set(first, 0);
+  order.Set(second, 1);
+  order.Set(third, 2);
+  return order;
+}
+
+}  // namespace proud_color_sorter::samples
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_samples.hpp>
+#include <color_sequence_batch.hpp>
+#include <counting_sort.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+std::vector<Color> Sequence(const ColorSequenceBatch& batch, const std::size_t index) {
+  return {batch.Begin(index), batch.End(index)};
+}
+
+}  // namespace
+
+TEST(ColorSequenceBatchTests, empty_batch) {
+  ColorSequenceBatch batch;
+
+  ASSERT_TRUE(batch.IsEmpty());
+  ASSERT_EQ(batch.Size(), 0);
+  ASSERT_EQ(batch.ColorCount(), 0);
+  ASSERT_EQ(batch.Offsets(), std::pmr::vector<std::size_t>{0});
+}
+
+TEST(ColorSequenceBatchTests, add_sequences) {
+  const std::vector<Color> first{Color::kRed, Color::kBlue};
+  const std::vector<Color> second{Color::kGreen, Color::kGreen, Color::kRed};
+  ColorSequenceBatch batch;
+
+  batch.Add(first.data(), first.data() + first.size());
+  batch.Add(nullptr, nullptr);
+  Color* out = batch.Add(second.size());
+  std::copy(second.begin(), second.end(), out);
+
+  ASSERT_EQ(batch.Size(), 3);
+  ASSERT_EQ(batch.ColorCount(), 5);
+  ASSERT_EQ(batch.SequenceSize(1), 0);
+  ASSERT_EQ(Sequence(batch, 0), first);
+  ASSERT_TRUE(Sequence(batch, 1).empty());
+  ASSERT_EQ(Sequence(batch, 2), second);
+}
+
+TEST(ColorSequenceBatchTests, clear_keeps_memory) {
+  const std::vector<Color> colors(100, Color::kRed);
+  ColorSequenceBatch batch;
+  batch.Add(colors.data(), colors.data() + colors.size());
+  const Color* data = batch.Colors().data();
+
+  batch.Clear();
+  ASSERT_TRUE(batch.IsEmpty());
+
+  batch.Add(colors.data(), colors.data() + colors.size());
+  ASSERT_EQ(batch.Colors().data(), data);
+}
+
+TEST(ColorSequenceBatchTests, moved_from_batch_is_empty_and_reusable) {
+  const std::vector<Color> colors{Color::kGreen, Color::kRed};
+  std::pmr::monotonic_buffer_resource other_resource;
+  ColorSequenceBatch batch;
+  batch.Add(colors.data(), colors.data() + colors.size());
+
+  ColorSequenceBatch moved{std::move(batch)};
+  ASSERT_EQ(moved.Size(), 1);
+
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  ASSERT_TRUE(batch.IsEmpty());
+  ASSERT_EQ(batch.Size(), 0);
+  ASSERT_EQ(batch.ColorCount(), 0);
+
+  ColorSequenceBatch moved_with_allocator{std::move(moved), &other_resource};
+  ASSERT_EQ(Sequence(moved_with_allocator, 0), colors);
+  ASSERT_EQ(moved.Size(), 0);  // NOLINT(bugprone-use-after-move)
+
+  moved = std::move(moved_with_allocator);
+  ASSERT_EQ(Sequence(moved, 0), colors);
+  ASSERT_TRUE(moved_with_allocator.IsEmpty());  // NOLINT(bugprone-use-after-move)
+
+  batch.Clear();
+  batch.Add(colors.data(), colors.data() + colors.size());
+  ASSERT_EQ(batch.Size(), 1);
+  ASSERT_EQ(Sequence(batch, 0), colors);
+}
+
+TEST(ColorSequenceBatchTests, allocates_from_given_resource) {
+  std::array<std::byte, 4096> arena{};
+  std::pmr::monotonic_buffer_resource resource{arena.data(), arena.size(), std::pmr::null_memory_resource()};
+  const std::vector<Color> colors(64, Color::kGreen);
+
+  ColorSequenceBatch batch{&resource};
+  ASSERT_EQ(batch.GetResource(), &resource);
+  batch.Reserve(8, 8 * colors.size());
+
+  for (std::size_t i = 0; i < 8; ++i) {
+    batch.Add(colors.data(), colors.data() + colors.size());
+  }
+
+  ASSERT_EQ(batch.ColorCount(), 8 * colors.size());
+}
+
+TEST(ColorSequenceBatchTests, pmr_container_passes_its_resource) {
+  std::pmr::unsynchronized_pool_resource resource;
+  const std::vector<Color> colors{Color::kBlue, Color::kRed};
+  std::pmr::vector<ColorSequenceBatch> batches{&resource};
+
+  // Growing the container moves batches with its allocator.
+  for (std::size_t i = 0; i < 16; ++i) {
+    batches.emplace_back().Add(colors.data(), colors.data() + colors.size());
+  }
+
+  for (const auto& batch : batches) {
+    ASSERT_EQ(batch.GetResource(), &resource);
+    ASSERT_EQ(Sequence(batch, 0), colors);
+  }
+
+  std::pmr::monotonic_buffer_resource other_resource;
+  const std::pmr::vector<ColorSequenceBatch> copies{batches, &other_resource};
+
+  ASSERT_EQ(copies.size(), batches.size());
+  ASSERT_EQ(copies.back().GetResource(), &other_resource);
+  ASSERT_EQ(Sequence(copies.back(), 0), colors);
+}
+
+TEST(ColorSequenceBatchTests, counting_sort_sorts_every_sequence) {
+  const auto order = samples::MakeOrder();
+  const std::vector<std::vector<Color>> sequences{
+      {},
+      {Color::kRed},
+      {Color::kGreen, Color::kRed, Color::kBlue, Color::kRed},
+      std::vector<Color>(200, Color::kGreen),
+  };
+  ColorSequenceBatch batch;
+
+  for (const auto& sequence : sequences) {
+    batch.Add(sequence.data(), sequence.data() + sequence.size());
+  }
+
+  std::vector<Color> long_sequence;
+
+  for (std::size_t i = 0; i < 300; ++i) {
+    long_sequence.push_back(static_cast<Color>(i % kColorSize));
+  }
+
+  batch.Add(long_sequence.data(), long_sequence.data() + long_sequence.size());
+
+  CountingSort(batch, order);
+
+  for (std::size_t i = 0; i < sequences.size(); ++i) {
+    ASSERT_EQ(Sequence(batch, i), CountingSort(sequences[i], order));
+  }
+
+  ASSERT_EQ(Sequence(batch, sequences.size()), CountingSort(long_sequence, order));
+}
+
+}  // namespace proud_color_sorter::tests
@@ -0,0 +1,117 @@
+#include <unistd.h>
+
+#include <array>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_histogram.hpp>
+#include <counting_sort.hpp>
+#include <sorted_runs.hpp>
+#include <utils/color_writer.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(ColorWriterTests, append_sequence) {
+  const std::vector<Color> colors{Color::kRed, Color::kBlue, Color::kGreen};
+  utils::ColorWriter writer;
+
+  writer.AppendSequence("Generated colors", colors.data(), colors.data() + colors.size());
+
+  ASSERT_EQ(writer.View(), "Generated colors (size=3): R B G \n");
+}
+
+TEST(ColorWriterTests, append_empty_sequence) {
+  utils::ColorWriter writer;
+
+  writer.AppendSequence("Sorted colors", nullptr, nullptr);
+
+  ASSERT_EQ(writer.View(), "Sorted colors (size=0):  \n");
+}
+
+TEST(ColorWriterTests, append_summary) {
+  const std::vector<Color> colors{Color::kRed, Color::kBlue, Color::kRed, Color::kBlue, Color::kBlue};
+  ColorOrder order;
+  order.Set(Color::kBlue, 0);
+  order.Set(Color::kGreen, 1);
+  order.Set(Color::kRed, 2);
+  utils::ColorWriter writer;
+
+  writer.AppendSummary("Sorted colors",
+                       SortedRuns{CountColorsScalar(colors.data(), colors.data() + colors.size()), order});
+
+  ASSERT_EQ(writer.View(), "Sorted colors (size=5): B=3 G=0 R=2 \n");
+}
+
+TEST(ColorWriterTests, buffer_grows_and_keeps_text) {
+  const std::vector<Color> colors(1000, Color::kGreen);
+  utils::ColorWriter writer{16};
+  std::string expected;
+
+  for (std::size_t i = 0; i < 10; ++i) {
+    writer.AppendSequence("Colors", colors.data(), colors.data() + colors.size());
+    writer.Append("|");
+    expected += "Colors (size=1000): ";
+
+    for (std::size_t j = 0; j < colors.size(); ++j) {
+      expected += "G ";
+    }
+
+    expected += "\n|";
+  }
+
+  ASSERT_EQ(writer.View(), expected);
+  writer.Clear();
+  ASSERT_TRUE(writer.IsEmpty());
+}
+
+TEST(ColorWriterTests, buffer_is_taken_over_and_released) {
+  utils::TextBuffer buffer;
+  buffer.reserve(128);
+  buffer.push_back('x');
+  const char* data = buffer.data();
+
+  utils::ColorWriter writer{std::move(buffer)};
+  ASSERT_TRUE(writer.IsEmpty());
+
+  writer.Append("text");
+  ASSERT_EQ(writer.View(), "text");
+  ASSERT_EQ(writer.View().data(), data);
+
+  const auto released = writer.ReleaseBuffer();
+  ASSERT_EQ(released.data(), data);
+  ASSERT_TRUE(writer.IsEmpty());
+
+  writer.Append("more");
+  ASSERT_EQ(writer.View(), "more");
+}
+
+TEST(ColorWriterTests, flush_to_file_descriptor) {
+  std::array<int, 2> pipe_fds{};
+  ASSERT_EQ(::pipe(pipe_fds.data()), 0);
+
+  const std::vector<Color> colors{Color::kBlue, Color::kRed};
+  utils::ColorWriter writer;
+  writer.AppendSequence("Sorted colors", colors.data(), colors.data() + colors.size());
+  const std::string expected{writer.View()};
+
+  writer.FlushTo(pipe_fds[1]);
+  ::close(pipe_fds[1]);
+  ASSERT_TRUE(writer.IsEmpty());
+
+  std::string written(expected.size() + 1, '\0');
+  const auto read = ::read(pipe_fds[0], written.data(), written.size());
+  ::close(pipe_fds[0]);
+
+  ASSERT_EQ(read, static_cast<::ssize_t>(expected.size()));
+  written.resize(expected.size());
+  ASSERT_EQ(written, expected);
+}
+
+TEST(ColorWriterTests, write_to_closed_descriptor_throws) {
+  ASSERT_THROW(utils::WriteAll(-1, "text"), std::system_error);
+}
+
+}  // namespace proud_color_sorter::tests
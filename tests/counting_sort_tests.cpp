@@ -1,10 +1,15 @@
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 
 #include <gtest/gtest.h>
 
 #include <counting_sort.hpp>
 #include <order.hpp>
+#include <utils/random_generator.hpp>
 
 namespace proud_color_sorter::tests {
 
@@ -65,4 +70,240 @@ TEST(CountingSortTest, ascending_input) {
   EXPECT_EQ(sorted_colors, colors);
 }
 
+TEST(SortInPlaceTest, empty_array) {
+  std::vector<Color> colors;
+  ColorOrder order;
+  order.Set(Color::kRed, 0);
+  order.Set(Color::kGreen, 1);
+  order.Set(Color::kBlue, 2);
+
+  SortInPlace(colors, order);
+
+  ASSERT_TRUE(colors.empty());
+}
+
+TEST(SortInPlaceTest, matches_counting_sort) {
+  std::vector<Color> colors{Color::kBlue, Color::kRed,  Color::kGreen, Color::kGreen, Color::kRed,
+                            Color::kBlue, Color::kBlue, Color::kRed,   Color::kGreen, Color::kBlue};
+  ColorOrder order;
+  order.Set(Color::kGreen, 0);
+  order.Set(Color::kBlue, 1);
+  order.Set(Color::kRed, 2);
+
+  auto sorted_colors = CountingSort(colors, order);
+  SortInPlace(colors, order);
+
+  EXPECT_EQ(sorted_colors, colors);
+}
+
+TEST(SortInPlaceTest, single_color) {
+  std::vector<Color> colors(5, Color::kGreen);
+  ColorOrder order;
+  order.Set(Color::kRed, 0);
+  order.Set(Color::kBlue, 1);
+  order.Set(Color::kGreen, 2);
+
+  SortInPlace(colors, order);
+
+  EXPECT_EQ(colors, std::vector<Color>(5, Color::kGreen));
+}
+
+TEST(CountingSortTest, into_buffer) {
+  std::vector<Color> colors{Color::kBlue, Color::kRed, Color::kGreen, Color::kBlue, Color::kRed, Color::kBlue};
+  ColorOrder order;
+  order.Set(Color::kBlue, 0);
+  order.Set(Color::kRed, 1);
+  order.Set(Color::kGreen, 2);
+
+  std::vector<Color> sorted_colors(colors.size());
+  CountingSort(colors.data(), colors.data() + colors.size(), order, sorted_colors.data());
+
+  EXPECT_EQ(sorted_colors, CountingSort(colors, order));
+
+  CountingSort(colors.data(), colors.data() + colors.size(), order, colors.data());
+
+  EXPECT_EQ(sorted_colors, colors);
+}
+
+TEST(CountingSortTest, fill_sorted_colors) {
+  ColorHistogram histogram{};
+  histogram[static_cast<std::size_t>(Color::kRed)] = 2;
+  histogram[static_cast<std::size_t>(Color::kBlue)] = 1;
+  ColorOrder order;
+  order.Set(Color::kBlue, 0);
+  order.Set(Color::kGreen, 1);
+  order.Set(Color::kRed, 2);
+
+  std::vector<Color> colors(3);
+  Color* end = FillSortedColors(histogram, order, colors.data());
+
+  EXPECT_EQ(end, colors.data() + colors.size());
+  EXPECT_EQ(colors, (std::vector<Color>{Color::kBlue, Color::kRed, Color::kRed}));
+}
+
+namespace {
+
+/// Small record, scattered a record at a time.
+struct Pixel {
+  Color color;
+  std::uint32_t index;
+};
+
+/// Large record, scattered through staging buffers.
+struct Particle {
+  std::array<double, 6> payload;
+  std::size_t index;
+  Color color;
+};
+
+template <typename Record>
+std::vector<Record> MakeRecords(const std::size_t size) {
+  utils::Xoshiro256StarStar engine{size};
+  std::vector<Record> records(size);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    records[i].color = static_cast<Color>(engine() % kColorSize);
+    records[i].index = static_cast<decltype(records[i].index)>(i);
+  }
+
+  return records;
+}
+
+template <typename Record>
+void ExpectSortedLikeStableSort(const std::vector<Record>& records, const ColorOrder& order) {
+  std::vector<Record> expected = records;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&order](const Record& lhs, const Record& rhs) { return order.IsLess(lhs.color, rhs.color); });
+
+  std::vector<Record> sorted(records.size());
+  CountingSortBy(records.data(), records.data() + records.size(), order, &Record::color, sorted.data());
+
+  ASSERT_EQ(sorted.size(), expected.size());
+
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    ASSERT_EQ(sorted[i].color, expected[i].color) << "i=" << i;
+    ASSERT_EQ(sorted[i].index, expected[i].index) << "i=" << i;
+  }
+}
+
+}  // namespace
+
+TEST(CountingSortTest, sort_records_by_color) {
+  ColorOrder order;
+  order.Set(Color::kGreen, 0);
+  order.Set(Color::kBlue, 1);
+  order.Set(Color::kRed, 2);
+
+  const std::vector<Pixel> pixels{{Color::kRed, 0}, {Color::kBlue, 1}, {Color::kGreen, 2}, {Color::kRed, 3},
+                                  {Color::kGreen, 4}};
+  std::vector<Pixel> sorted(pixels.size());
+  CountingSortBy(pixels.data(), pixels.data() + pixels.size(), order,
+                 [](const Pixel& pixel) { return pixel.color; }, sorted.data());
+
+  std::vector<std::uint32_t> indices;
+
+  for (const Pixel& pixel : sorted) {
+    indices.push_back(pixel.index);
+  }
+
+  EXPECT_EQ(indices, (std::vector<std::uint32_t>{2, 4, 1, 0, 3}));
+}
+
+TEST(CountingSortTest, sort_records_is_stable) {
+  ColorOrder order;
+  order.Set(Color::kBlue, 0);
+  order.Set(Color::kRed, 1);
+  order.Set(Color::kGreen, 2);
+
+  for (const std::size_t size : std::vector<std::size_t>{0, 1, 100, 10007}) {
+    ExpectSortedLikeStableSort(MakeRecords<Pixel>(size), order);
+    ExpectSortedLikeStableSort(MakeRecords<Particle>(size), order);
+  }
+}
+
+TEST(CountingSortTest, sort_large_records_through_staging) {
+  ColorOrder order;
+  order.Set(Color::kRed, 0);
+  order.Set(Color::kBlue, 1);
+  order.Set(Color::kGreen, 2);
+
+  static_assert(detail::kIsStagedRecord<Particle>);
+  ExpectSortedLikeStableSort(MakeRecords<Particle>(detail::kStagedOutputMinSize / sizeof(Particle) + 7), order);
+}
+
+TEST(CountingSortTest, all_color_orders) {
+  static_assert(kAllColorOrders[0].GetElement(0) == Color::kRed);
+  static_assert(kAllColorOrders[kColorOrderCount - 1].GetElement(0) == Color::kBlue);
+
+  for (std::size_t i = 0; i < kAllColorOrders.size(); ++i) {
+    EXPECT_EQ(GetColorOrderIndex(kAllColorOrders[i]), i);
+
+    for (std::size_t j = 0; j < i; ++j) {
+      EXPECT_FALSE(std::equal(kAllColorOrders[i].begin(), kAllColorOrders[i].end(), kAllColorOrders[j].begin()))
+          << i << " " << j;
+    }
+  }
+
+  ColorOrder order;
+  order.Set(Color::kGreen, 0);
+  order.Set(Color::kBlue, 1);
+  order.Set(Color::kRed, 2);
+
+  EXPECT_EQ(GetColorOrderIndex(order), 3);
+}
+
+TEST(CountingSortTest, invalid_color_order_is_rejected) {
+  ColorOrder order;
+  order.Set(Color::kRed, 0);
+  order.Set(Color::kRed, 1);
+  order.Set(Color::kBlue, 2);
+
+  EXPECT_THROW(GetColorOrderIndex(order), std::invalid_argument);
+  EXPECT_THROW(GetColorSortKernels(order), std::invalid_argument);
+  EXPECT_THROW(GetColorSortKernels(ColorOrder{}), std::invalid_argument);
+}
+
+TEST(CountingSortTest, multi_order) {
+  const auto records = MakeRecords<Pixel>(1000);
+  std::vector<Color> colors;
+
+  for (const Pixel& pixel : records) {
+    colors.push_back(pixel.color);
+  }
+
+  const std::vector<ColorOrder> orders(kAllColorOrders.begin(), kAllColorOrders.end());
+  const auto sorted_colors = CountingSortMultiOrder(colors, orders);
+
+  ASSERT_EQ(sorted_colors.size(), orders.size());
+
+  for (std::size_t i = 0; i < orders.size(); ++i) {
+    EXPECT_EQ(sorted_colors[i], CountingSort(colors, orders[i])) << "order #" << i;
+  }
+
+  EXPECT_TRUE(CountingSortMultiOrder(colors, {}).empty());
+}
+
+TEST(CountingSortTest, order_kernels_match_generic_sort) {
+  for (const ColorOrder& order : kAllColorOrders) {
+    const ColorSortKernels& kernels = GetColorSortKernels(order);
+
+    for (const std::size_t size : std::vector<std::size_t>{0, 1, 2, 3, 100, 4099}) {
+      std::vector<Color> colors;
+
+      for (const Pixel& pixel : MakeRecords<Pixel>(size)) {
+        colors.push_back(pixel.color);
+      }
+
+      const auto expected = CountingSort(colors, order);
+
+      std::vector<Color> sorted(colors.size());
+      kernels.counting_sort(colors.data(), colors.data() + colors.size(), sorted.data());
+      EXPECT_EQ(sorted, expected) << "order #" << GetColorOrderIndex(order) << ", size=" << size;
+
+      kernels.sort_in_place(colors.data(), colors.data() + colors.size());
+      EXPECT_EQ(colors, expected) << "order #" << GetColorOrderIndex(order) << ", size=" << size;
+    }
+  }
+}
+
 }  // namespace proud_color_sorter::tests
@@ -0,0 +1,118 @@
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_samples.hpp>
+#include <counting_sort.hpp>
+#include <utils/file_sort.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+constexpr ColorOrder kOrder = samples::MakeOrder(Color::kGreen, Color::kBlue, Color::kRed);
+
+std::filesystem::path TemporaryPath(const std::string& name) {
+  return std::filesystem::temp_directory_path() / ("pcs_file_sort_tests_" + name);
+}
+
+void WriteColors(const std::filesystem::path& path, const std::vector<Color>& colors) {
+  std::ofstream file{path, std::ios::binary};
+  file.write(reinterpret_cast<const char*>(colors.data()), static_cast<std::streamsize>(colors.size()));
+}
+
+std::vector<Color> ReadColors(const std::filesystem::path& path) {
+  std::vector<Color> colors(std::filesystem::file_size(path));
+  std::ifstream file{path, std::ios::binary};
+  file.read(reinterpret_cast<char*>(colors.data()), static_cast<std::streamsize>(colors.size()));
+  return colors;
+}
+
+std::vector<Color> MakeColors(const std::size_t size) {
+  std::vector<Color> colors;
+
+  for (std::size_t i = 0; i < size; ++i) {
+    colors.push_back(static_cast<Color>((i * 7 + i / 3) % kColorSize));
+  }
+
+  return colors;
+}
+
+}  // namespace
+
+TEST(FileSortTests, sort_to_output_file) {
+  const auto input = TemporaryPath("input");
+  const auto output = TemporaryPath("output");
+  const auto colors = MakeColors(100'000);
+  WriteColors(input, colors);
+
+  const auto stats = utils::SortFile(input, output, kOrder, {/*thread_count=*/4, /*serial_threshold=*/1024});
+
+  ASSERT_EQ(stats.size, colors.size());
+  ASSERT_GE(stats.GigabytesPerSecond(), 0);
+  ASSERT_EQ(ReadColors(output), CountingSort(colors, kOrder));
+  ASSERT_EQ(ReadColors(input), colors);
+
+  std::filesystem::remove(input);
+  std::filesystem::remove(output);
+}
+
+TEST(FileSortTests, sort_in_place) {
+  const auto path = TemporaryPath("in_place");
+  const auto colors = MakeColors(100'000);
+  WriteColors(path, colors);
+
+  utils::SortFileInPlace(path, kOrder, {/*thread_count=*/3, /*serial_threshold=*/1024});
+
+  ASSERT_EQ(ReadColors(path), CountingSort(colors, kOrder));
+  std::filesystem::remove(path);
+}
+
+TEST(FileSortTests, output_equal_to_input_is_rejected) {
+  const auto path = TemporaryPath("same_output");
+  const auto colors = MakeColors(1000);
+  WriteColors(path, colors);
+
+  ASSERT_THROW(utils::SortFile(path, path, kOrder), std::invalid_argument);
+  ASSERT_THROW(utils::SortFile(path, "", kOrder), std::invalid_argument);
+
+  ASSERT_EQ(ReadColors(path), colors);
+  std::filesystem::remove(path);
+}
+
+TEST(FileSortTests, invalid_color_is_rejected_before_writing) {
+  const auto input = TemporaryPath("invalid_input");
+  const auto output = TemporaryPath("invalid_output");
+  auto colors = MakeColors(10'000);
+  colors[7'777] = static_cast<Color>(kColorSize);
+  WriteColors(input, colors);
+  std::filesystem::remove(output);
+
+  ASSERT_THROW(utils::SortFile(input, output, kOrder), std::runtime_error);
+  ASSERT_FALSE(std::filesystem::exists(output));
+
+  ASSERT_THROW(utils::SortFileInPlace(input, kOrder), std::runtime_error);
+  ASSERT_EQ(ReadColors(input), colors);
+
+  std::filesystem::remove(input);
+}
+
+TEST(FileSortTests, empty_file) {
+  const auto input = TemporaryPath("empty_input");
+  const auto output = TemporaryPath("empty_output");
+  WriteColors(input, {});
+
+  const auto stats = utils::SortFile(input, output, kOrder);
+
+  ASSERT_EQ(stats.size, 0);
+  ASSERT_TRUE(ReadColors(output).empty());
+
+  std::filesystem::remove(input);
+  std::filesystem::remove(output);
+}
+
+}  // namespace proud_color_sorter::tests
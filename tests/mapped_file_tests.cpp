@@ -0,0 +1,82 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+#include <utils/mapped_file.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+std::filesystem::path TemporaryPath(const std::string& name) {
+  return std::filesystem::temp_directory_path() / ("pcs_mapped_file_tests_" + name);
+}
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::string content(std::filesystem::file_size(path), '\0');
+  std::ifstream file{path, std::ios::binary};
+  file.read(content.data(), static_cast<std::streamsize>(content.size()));
+  return content;
+}
+
+}  // namespace
+
+TEST(MappedFileTests, open_maps_whole_file) {
+  const auto path = TemporaryPath("open");
+  std::ofstream{path, std::ios::binary} << "colors";
+
+  {
+    const auto file = utils::MappedFile::Open(path, utils::MappedFile::Access::kReadOnly);
+    file.AdviseSequential();
+    ASSERT_EQ(file.Size(), 6);
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(file.Data()), file.Size()), "colors");
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTests, writes_are_carried_to_file) {
+  const auto path = TemporaryPath("write");
+
+  {
+    const auto file = utils::MappedFile::Create(path, 3);
+    ASSERT_EQ(file.Size(), 3);
+    file.Data()[0] = std::byte{'a'};
+    file.Data()[1] = std::byte{'b'};
+    file.Data()[2] = std::byte{'c'};
+  }
+
+  ASSERT_EQ(ReadFile(path), "abc");
+
+  {
+    const auto file = utils::MappedFile::Open(path, utils::MappedFile::Access::kReadWrite);
+    file.Data()[1] = std::byte{'x'};
+  }
+
+  ASSERT_EQ(ReadFile(path), "axc");
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTests, empty_file) {
+  const auto path = TemporaryPath("empty");
+
+  {
+    const auto file = utils::MappedFile::Create(path, 0);
+    file.AdviseSequential();
+    ASSERT_EQ(file.Size(), 0);
+    ASSERT_EQ(file.Data(), nullptr);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTests, open_missing_file_throws) {
+  ASSERT_THROW(utils::MappedFile::Open(TemporaryPath("missing"), utils::MappedFile::Access::kReadOnly),
+               std::system_error);
+}
+
+}  // namespace proud_color_sorter::tests
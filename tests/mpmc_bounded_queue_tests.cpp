@@ -0,0 +1,145 @@
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <mpmc_bounded_queue.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(MPMCBoundedQueueTests, fifo_across_ring_end) {
+  MPMCBoundedBlockingQueue<int> queue{3};
+  EXPECT_EQ(queue.Capacity(), 3);
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(queue.Put(2 * i));
+    EXPECT_TRUE(queue.Put(2 * i + 1));
+    EXPECT_EQ(queue.Take().value(), 2 * i);
+    EXPECT_EQ(queue.Take().value(), 2 * i + 1);
+  }
+}
+
+TEST(MPMCBoundedQueueTests, close_and_cancel) {
+  MPMCBoundedBlockingQueue<int> closed_queue{4};
+  EXPECT_TRUE(closed_queue.Put(1));
+  closed_queue.Close();
+  EXPECT_FALSE(closed_queue.Put(2));
+  EXPECT_EQ(closed_queue.Take().value(), 1);
+  EXPECT_FALSE(closed_queue.Take().has_value());
+
+  MPMCBoundedBlockingQueue<int> cancelled_queue{4};
+  EXPECT_TRUE(cancelled_queue.Put(1));
+  cancelled_queue.Cancel();
+  EXPECT_FALSE(cancelled_queue.Take().has_value());
+}
+
+TEST(MPMCBoundedQueueTests, put_blocks_caller_on_full_queue) {
+  MPMCBoundedBlockingQueue<int> queue{2};
+  std::atomic<bool> element_put = false;
+  ASSERT_TRUE(queue.Put(1));
+  ASSERT_TRUE(queue.Put(2));
+
+  auto producer = std::thread([&]() mutable {
+    EXPECT_TRUE(queue.Put(3));
+    element_put.store(true);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(element_put.load());
+  EXPECT_EQ(queue.Take().value(), 1);
+
+  producer.join();
+  EXPECT_TRUE(element_put.load());
+  EXPECT_EQ(queue.Take().value(), 2);
+  EXPECT_EQ(queue.Take().value(), 3);
+}
+
+TEST(MPMCBoundedQueueTests, cancel_wakes_up_blocked_producer) {
+  MPMCBoundedBlockingQueue<int> queue{1};
+  ASSERT_TRUE(queue.Put(1));
+
+  auto producer = std::thread([&]() mutable { EXPECT_FALSE(queue.Put(2)); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  queue.Cancel();
+  producer.join();
+  EXPECT_FALSE(queue.Take().has_value());
+}
+
+TEST(MPMCBoundedQueueTests, batch_larger_than_capacity) {
+  MPMCBoundedBlockingQueue<int> queue{4};
+  std::vector<int> elements(100);
+
+  for (std::size_t i = 0; i < elements.size(); ++i) {
+    elements[i] = static_cast<int>(i);
+  }
+
+  auto producer = std::thread([&]() mutable {
+    EXPECT_TRUE(queue.PutBatch(elements.begin(), elements.end()));
+    queue.Close();
+  });
+
+  std::vector<int> taken;
+
+  while (queue.TakeBatch(std::back_inserter(taken), 3) > 0) {
+    EXPECT_LE(taken.size(), elements.size());
+  }
+
+  producer.join();
+  EXPECT_EQ(taken, elements);
+  EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 0), 0);
+}
+
+TEST(MPMCBoundedQueueTests, stress_many_producers_and_consumers) {
+  constexpr int kProducers = 4;
+  constexpr int kConsumers = 4;
+  constexpr int kElementsPerProducer = 50'000;
+  MPMCBoundedBlockingQueue<int> queue{64};
+  std::atomic<long long> sum = 0;
+  std::atomic<int> taken = 0;
+
+  std::vector<std::thread> consumers;
+
+  for (int consumer = 0; consumer < kConsumers; ++consumer) {
+    consumers.emplace_back([&]() mutable {
+      std::vector<int> batch;
+
+      while (queue.TakeBatch(std::back_inserter(batch), 16) > 0) {
+        for (const int element : batch) {
+          sum.fetch_add(element);
+        }
+
+        taken.fetch_add(static_cast<int>(batch.size()));
+        batch.clear();
+      }
+    });
+  }
+
+  std::vector<std::thread> producers;
+
+  for (int producer = 0; producer < kProducers; ++producer) {
+    producers.emplace_back([&]() mutable {
+      for (int i = 0; i < kElementsPerProducer; ++i) {
+        EXPECT_TRUE(queue.Put(i));
+      }
+    });
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  queue.Close();
+
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  EXPECT_EQ(taken.load(), kProducers * kElementsPerProducer);
+  EXPECT_EQ(sum.load(), static_cast<long long>(kProducers) * kElementsPerProducer * (kElementsPerProducer - 1) / 2);
+}
+
+}  // namespace proud_color_sorter::tests
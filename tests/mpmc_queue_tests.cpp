@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <mpmc_queue.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(MPMCQueueTests, fifo) {
+  MPMCUnboundedBlockingQueue<int> queue;
+
+  EXPECT_TRUE(queue.Put(1));
+  EXPECT_TRUE(queue.Put(2));
+
+  EXPECT_EQ(queue.Take().value(), 1);
+  EXPECT_EQ(queue.Take().value(), 2);
+}
+
+TEST(MPMCQueueTests, close_and_cancel) {
+  MPMCUnboundedBlockingQueue<int> closed_queue;
+  EXPECT_TRUE(closed_queue.Put(1));
+  closed_queue.Close();
+  EXPECT_FALSE(closed_queue.Put(2));
+  EXPECT_EQ(closed_queue.Take().value(), 1);
+  EXPECT_FALSE(closed_queue.Take().has_value());
+
+  MPMCUnboundedBlockingQueue<int> cancelled_queue;
+  EXPECT_TRUE(cancelled_queue.Put(1));
+  cancelled_queue.Cancel();
+  EXPECT_FALSE(cancelled_queue.Take().has_value());
+}
+
+TEST(MPMCQueueTests, close_wakes_up_all_consumers) {
+  MPMCUnboundedBlockingQueue<int> queue;
+  std::atomic<int> woke_up = 0;
+  std::vector<std::thread> consumers;
+
+  for (int i = 0; i < 4; ++i) {
+    consumers.emplace_back([&]() mutable {
+      std::vector<int> taken;
+      EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 10), 0);
+      woke_up.fetch_add(1);
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(woke_up.load(), 0);
+  queue.Close();
+
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  EXPECT_EQ(woke_up.load(), 4);
+}
+
+TEST(MPMCQueueTests, concurrent_consumers_take_every_element_once) {
+  constexpr int kElements = 10'000;
+  MPMCUnboundedBlockingQueue<int> queue;
+  std::mutex consumed_lock;
+  std::vector<int> consumed;
+  std::vector<std::thread> consumers;
+
+  for (int i = 0; i < 4; ++i) {
+    consumers.emplace_back([&]() mutable {
+      std::vector<int> batch;
+
+      while (queue.TakeBatch(std::back_inserter(batch), 16) > 0) {
+        std::lock_guard lock{consumed_lock};
+        consumed.insert(consumed.end(), batch.begin(), batch.end());
+        batch.clear();
+      }
+    });
+  }
+
+  std::vector<int> elements(kElements);
+  std::iota(elements.begin(), elements.end(), 0);
+  EXPECT_TRUE(queue.PutBatch(elements.begin(), elements.begin() + kElements / 2));
+
+  for (int i = kElements / 2; i < kElements; ++i) {
+    EXPECT_TRUE(queue.Put(i));
+  }
+
+  queue.Close();
+
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  std::sort(consumed.begin(), consumed.end());
+  EXPECT_EQ(consumed, elements);
+}
+
+}  // namespace proud_color_sorter::tests
@@ -0,0 +1,215 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <mpsc_bounded_queue.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(MPSCBoundedQueueTests, capacity_is_rounded_up) {
+  MPSCBoundedLockFreeQueue<int> queue{5};
+
+  EXPECT_EQ(queue.Capacity(), 8);
+}
+
+TEST(MPSCBoundedQueueTests, put_and_take) {
+  MPSCBoundedLockFreeQueue<int> queue{4};
+  ASSERT_TRUE(queue.Put(1));
+
+  auto element = queue.Take();
+  ASSERT_TRUE(element.has_value());
+  EXPECT_EQ(element.value(), 1);
+}
+
+TEST(MPSCBoundedQueueTests, try_put_on_full_queue) {
+  MPSCBoundedLockFreeQueue<int> queue{2};
+
+  EXPECT_TRUE(queue.TryPut(1));
+  EXPECT_TRUE(queue.TryPut(2));
+  EXPECT_FALSE(queue.TryPut(3));
+
+  EXPECT_EQ(queue.Take().value(), 1);
+  EXPECT_TRUE(queue.TryPut(3));
+}
+
+TEST(MPSCBoundedQueueTests, try_put_keeps_element_on_failure) {
+  MPSCBoundedLockFreeQueue<std::vector<int>> queue{2};
+  queue.Close();
+
+  std::vector<int> element{1, 2, 3};
+  EXPECT_FALSE(queue.TryPut(std::move(element)));
+  EXPECT_EQ(element, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(MPSCBoundedQueueTests, put_blocks_caller_on_full_queue) {
+  MPSCBoundedLockFreeQueue<int> queue{2};
+  std::atomic<bool> element_put = false;
+  ASSERT_TRUE(queue.Put(1));
+  ASSERT_TRUE(queue.Put(2));
+
+  auto producer = std::thread([&]() mutable {
+    EXPECT_TRUE(queue.Put(3));
+    element_put.store(true);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(element_put.load());
+  EXPECT_EQ(queue.Take().value(), 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_TRUE(element_put.load());
+
+  producer.join();
+}
+
+TEST(MPSCBoundedQueueTests, take_blocks_caller_on_empty_queue) {
+  MPSCBoundedLockFreeQueue<int> queue{4};
+  std::atomic<bool> element_taken = false;
+
+  auto consumer = std::thread([&]() mutable {
+    auto element = queue.Take();
+    EXPECT_TRUE(element.has_value());
+    element_taken.store(true);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(element_taken.load());
+  EXPECT_TRUE(queue.Put(1));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_TRUE(element_taken.load());
+
+  consumer.join();
+}
+
+TEST(MPSCBoundedQueueTests, close) {
+  MPSCBoundedLockFreeQueue<int> queue{4};
+
+  EXPECT_TRUE(queue.Put(1));
+  queue.Close();
+  EXPECT_FALSE(queue.Put(2));
+  auto element_1 = queue.Take();
+  ASSERT_TRUE(element_1.has_value());
+  EXPECT_EQ(element_1.value(), 1);
+  auto element_2 = queue.Take();
+  EXPECT_FALSE(element_2.has_value());
+}
+
+TEST(MPSCBoundedQueueTests, cancel) {
+  MPSCBoundedLockFreeQueue<int> queue{4};
+
+  EXPECT_TRUE(queue.Put(1));
+  queue.Cancel();
+  EXPECT_FALSE(queue.Put(2));
+  auto element = queue.Take();
+  EXPECT_FALSE(element.has_value());
+}
+
+TEST(MPSCBoundedQueueTests, close_wakes_up_consumer_and_producer) {
+  MPSCBoundedLockFreeQueue<int> queue{2};
+  std::atomic<bool> is_consumer_woke_up = false;
+
+  auto consumer = std::thread([&]() mutable {
+    queue.Take();
+    is_consumer_woke_up.store(true);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(is_consumer_woke_up.load());
+  queue.Close();
+  consumer.join();
+  EXPECT_TRUE(is_consumer_woke_up.load());
+
+  MPSCBoundedLockFreeQueue<int> full_queue{2};
+  ASSERT_TRUE(full_queue.Put(1));
+  ASSERT_TRUE(full_queue.Put(2));
+
+  auto producer = std::thread([&]() mutable { EXPECT_FALSE(full_queue.Put(3)); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  full_queue.Cancel();
+  producer.join();
+}
+
+TEST(MPSCBoundedQueueTests, stress_many_producers) {
+  constexpr int kProducers = 4;
+  constexpr int kElementsPerProducer = 100'000;
+  MPSCBoundedLockFreeQueue<int> queue{64};
+
+  std::vector<std::thread> producers;
+
+  for (int producer = 0; producer < kProducers; ++producer) {
+    producers.emplace_back([&queue, producer]() mutable {
+      for (int i = 0; i < kElementsPerProducer; ++i) {
+        EXPECT_TRUE(queue.Put(producer * kElementsPerProducer + i));
+      }
+    });
+  }
+
+  auto closer = std::thread([&]() mutable {
+    for (auto& producer : producers) {
+      producer.join();
+    }
+
+    queue.Close();
+  });
+
+  // Elements of every producer must come in FIFO order.
+  std::vector<int> last_seen(kProducers, -1);
+  int taken = 0;
+
+  for (auto element = queue.Take(); element.has_value(); element = queue.Take()) {
+    const auto producer = static_cast<std::size_t>(element.value() / kElementsPerProducer);
+    const int index = element.value() % kElementsPerProducer;
+    EXPECT_EQ(index, last_seen[producer] + 1);
+    last_seen[producer] = index;
+    ++taken;
+  }
+
+  closer.join();
+
+  EXPECT_EQ(taken, kProducers * kElementsPerProducer);
+}
+
+TEST(MPSCBoundedQueueTests, stress_producers_close_while_consumer_is_parked) {
+  constexpr int kRounds = 2'000;
+  constexpr int kProducers = 3;
+
+  for (int round = 0; round < kRounds; ++round) {
+    // Producers of every other round put nothing, so the consumer is woken up only by Close.
+    const int elements_per_producer = round % 2 == 0 ? 0 : 4;
+    MPSCBoundedLockFreeQueue<int> queue{2};
+    std::atomic<int> running_producers = kProducers;
+
+    std::vector<std::thread> producers;
+
+    for (int producer = 0; producer < kProducers; ++producer) {
+      producers.emplace_back([&]() mutable {
+        for (int i = 0; i < elements_per_producer; ++i) {
+          EXPECT_TRUE(queue.Put(i));
+        }
+
+        if (running_producers.fetch_sub(1) == 1) {
+          queue.Close();
+        }
+      });
+    }
+
+    int taken = 0;
+
+    while (queue.Take().has_value()) {
+      ++taken;
+    }
+
+    for (auto& producer : producers) {
+      producer.join();
+    }
+
+    ASSERT_EQ(taken, kProducers * elements_per_producer);
+  }
+}
+
+}  // namespace proud_color_sorter::tests
@@ -1,6 +1,8 @@
 #include <atomic>
 #include <chrono>
+#include <iterator>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -149,4 +151,61 @@ TEST(MPSCQueueTests, cancel_wakes_up_consumer) {
   consumer.join();
 }
 
+TEST(MPSCQueueTests, put_batch_and_take_batch) {
+  MPSCUnboundedBlockingQueue<int> queue;
+  std::vector<int> elements{1, 2, 3, 4, 5};
+
+  EXPECT_TRUE(queue.PutBatch(elements.begin(), elements.end()));
+
+  std::vector<int> taken;
+  EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 3), 3);
+  EXPECT_EQ(taken, (std::vector<int>{1, 2, 3}));
+
+  EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 10), 2);
+  EXPECT_EQ(taken, elements);
+}
+
+TEST(MPSCQueueTests, batch_on_closed_queue) {
+  MPSCUnboundedBlockingQueue<int> queue;
+  std::vector<int> elements{1, 2};
+
+  EXPECT_TRUE(queue.Put(0));
+  queue.Close();
+  EXPECT_FALSE(queue.PutBatch(elements.begin(), elements.end()));
+
+  std::vector<int> taken;
+  EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 10), 1);
+  EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 10), 0);
+  EXPECT_EQ(taken, std::vector<int>{0});
+}
+
+TEST(MPSCQueueTests, take_batch_of_zero_elements_does_not_block) {
+  MPSCUnboundedBlockingQueue<int> queue;
+  std::vector<int> taken;
+
+  EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 0), 0);
+  EXPECT_TRUE(queue.Put(1));
+  EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 0), 0);
+  EXPECT_TRUE(taken.empty());
+}
+
+TEST(MPSCQueueTests, take_batch_blocks_caller_on_empty_queue) {
+  MPSCUnboundedBlockingQueue<int> queue;
+  std::atomic<bool> elements_taken = false;
+
+  auto consumer = std::thread([&]() mutable {
+    std::vector<int> taken;
+    EXPECT_EQ(queue.TakeBatch(std::back_inserter(taken), 10), 2);
+    elements_taken.store(true);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(elements_taken.load());
+  std::vector<int> elements{1, 2};
+  EXPECT_TRUE(queue.PutBatch(elements.begin(), elements.end()));
+
+  consumer.join();
+  EXPECT_TRUE(elements_taken.load());
+}
+
 }  // namespace proud_color_sorter::tests
\ No newline at end of file
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <array>
+
 #include <gtest/gtest.h>
 
 #include <color.hpp>
@@ -6,7 +9,7 @@
 
 namespace proud_color_sorter::tests {
 
-TEST(OrderTests, order) {
+TEST(OrderTest, order) {
   Order<Color, kColorSize> colors_order;
   colors_order.Set(Color::kBlue, 0);
   colors_order.Set(Color::kGreen, 1);
@@ -21,7 +24,7 @@ TEST(OrderTests, order) {
   EXPECT_EQ(colors_order.GetRank(Color::kRed), 2);
 }
 
-TEST(OrderTests, random_iterator_requirements) {
+TEST(OrderTest, random_iterator_requirements) {
   Order<Color, kColorSize> colors_order;
   colors_order.Set(Color::kBlue, 0);
   colors_order.Set(Color::kGreen, 1);
@@ -71,7 +74,7 @@ TEST(OrderTests, random_iterator_requirements) {
   EXPECT_EQ(first[2], *third);
 }
 
-TEST(OrderTests, const_random_iterator_requirements) {
+TEST(OrderTest, const_random_iterator_requirements) {
   Order<Color, kColorSize> colors_order;
   colors_order.Set(Color::kBlue, 0);
   colors_order.Set(Color::kGreen, 1);
@@ -121,7 +124,7 @@ TEST(OrderTests, const_random_iterator_requirements) {
   EXPECT_EQ(first[2], *third);
 }
 
-TEST(OrderTests, comparison_methods) {
+TEST(OrderTest, comparison_methods) {
   Order<Color, kColorSize> colors_order;
   colors_order.Set(Color::kBlue, 0);
   colors_order.Set(Color::kGreen, 1);
@@ -181,4 +184,40 @@ TEST(OrderTest, const_iterator_preserves_elements_order) {
   EXPECT_EQ(ordered_seq, collected_from_iterator);
 }
 
-}  // namespace proud_color_sorter::tests
\ No newline at end of file
+TEST(OrderTest, constexpr_dense_order) {
+  constexpr auto kColorsOrder = []() {
+    Order<Color, kColorSize> colors_order;
+    colors_order.Set(Color::kGreen, 0);
+    colors_order.Set(Color::kBlue, 1);
+    colors_order.Set(Color::kRed, 2);
+    return colors_order;
+  }();
+
+  static_assert(kColorsOrder.GetRank(Color::kGreen) == 0);
+  static_assert(kColorsOrder.GetRank(Color::kBlue) == 1);
+  static_assert(kColorsOrder.GetRank(Color::kRed) == 2);
+  static_assert(kColorsOrder.GetElement(0) == Color::kGreen);
+  static_assert(kColorsOrder.IsLess(Color::kBlue, Color::kRed));
+
+  EXPECT_EQ(kColorsOrder.GetRank(Color::kRed), 2);
+}
+
+TEST(OrderTest, dense_and_hash_storages_agree) {
+  Order<Color, kColorSize> dense_order;
+  Order<Color, kColorSize, HashRankStorage<Color, kColorSize>> hash_order;
+
+  const std::array<Color, kColorSize> elements{Color::kBlue, Color::kRed, Color::kGreen};
+
+  for (std::size_t i = 0; i < elements.size(); ++i) {
+    dense_order.Set(elements[i], i);
+    hash_order.Set(elements[i], i);
+  }
+
+  for (const Color color : elements) {
+    EXPECT_EQ(dense_order.GetRank(color), hash_order.GetRank(color));
+  }
+
+  EXPECT_TRUE(std::equal(dense_order.begin(), dense_order.end(), hash_order.begin(), hash_order.end()));
+}
+
+}  // namespace proud_color_sorter::tests
@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_samples.hpp>
+#include <counting_sort.hpp>
+#include <packed_color_sequence.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+std::vector<Color> Unpack(const PackedColorSequence& packed) {
+  std::vector<Color> colors(packed.Size());
+  packed.Unpack(colors.data());
+  return colors;
+}
+
+}  // namespace
+
+TEST(PackedColorSequenceTests, empty) {
+  PackedColorSequence packed;
+
+  EXPECT_TRUE(packed.IsEmpty());
+  EXPECT_EQ(packed.begin(), packed.end());
+  EXPECT_TRUE(packed.Words().empty());
+}
+
+TEST(PackedColorSequenceTests, push_back_and_get) {
+  PackedColorSequence packed;
+  packed.PushBack(Color::kBlue);
+  packed.PushBack(Color::kRed);
+  packed.PushBack(Color::kGreen);
+
+  ASSERT_EQ(packed.Size(), 3);
+  EXPECT_EQ(packed.Get(0), Color::kBlue);
+  EXPECT_EQ(packed.Get(1), Color::kRed);
+  EXPECT_EQ(packed.Get(2), Color::kGreen);
+
+  packed.Set(1, Color::kGreen);
+  EXPECT_EQ(packed.Get(1), Color::kGreen);
+  EXPECT_EQ(packed.Words().size(), 1);
+}
+
+TEST(PackedColorSequenceTests, bulk_append_round_trip) {
+  auto colors = samples::GenerateColors(1000);
+
+  PackedColorSequence packed;
+  packed.PushBack(colors[0]);
+  packed.Append(colors.data() + 1, colors.data() + colors.size());
+
+  EXPECT_EQ(packed.Size(), colors.size());
+  EXPECT_EQ(packed.Words().size(), (colors.size() + 31) / 32);
+  EXPECT_EQ(Unpack(packed), colors);
+  EXPECT_EQ(std::vector<Color>(packed.begin(), packed.end()), colors);
+}
+
+TEST(PackedColorSequenceTests, run_append) {
+  PackedColorSequence packed;
+  packed.Append(5, Color::kGreen);
+  packed.Append(70, Color::kBlue);
+  packed.Append(1, Color::kRed);
+
+  std::vector<Color> expected(5, Color::kGreen);
+  expected.insert(expected.end(), 70, Color::kBlue);
+  expected.push_back(Color::kRed);
+
+  EXPECT_EQ(Unpack(packed), expected);
+  EXPECT_EQ(packed, PackedColorSequence(expected.data(), expected.data() + expected.size()));
+}
+
+TEST(PackedColorSequenceTests, many_short_appends_grow_geometrically) {
+  constexpr std::size_t kAppends = 100'000;
+  const auto colors = samples::GenerateColors(kAppends);
+  PackedColorSequence packed;
+  std::size_t reallocations = 0;
+
+  for (std::size_t i = 0; i < kAppends; ++i) {
+    const auto* words = packed.Words().data();
+
+    if (i % 2 == 0) {
+      packed.Append(colors.data() + i, colors.data() + i + 1);
+    } else {
+      packed.Append(1, colors[i]);
+    }
+
+    if (packed.Words().data() != words) {
+      ++reallocations;
+    }
+  }
+
+  // Growing to the exact size would reallocate on every new word, i. e. thousands of times.
+  EXPECT_LT(reallocations, std::size_t{64});
+  EXPECT_EQ(Unpack(packed), colors);
+}
+
+TEST(PackedColorSequenceTests, count_colors) {
+  auto colors = samples::GenerateColors(1001);
+  PackedColorSequence packed{colors.data(), colors.data() + colors.size()};
+
+  EXPECT_EQ(CountColors(packed), CountColorsScalar(colors.data(), colors.data() + colors.size()));
+}
+
+TEST(PackedColorSequenceTests, counting_sort) {
+  ColorOrder order;
+  order.Set(Color::kBlue, 0);
+  order.Set(Color::kRed, 1);
+  order.Set(Color::kGreen, 2);
+
+  for (const std::size_t size : std::vector<std::size_t>{0, 1, 31, 32, 33, 1000}) {
+    auto colors = samples::GenerateColors(size);
+    PackedColorSequence packed{colors.data(), colors.data() + colors.size()};
+
+    auto sorted = CountingSort(packed, order);
+
+    EXPECT_EQ(Unpack(sorted), CountingSort(colors, order)) << "size: " << size;
+  }
+}
+
+}  // namespace proud_color_sorter::tests
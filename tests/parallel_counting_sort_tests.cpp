@@ -0,0 +1,76 @@
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_samples.hpp>
+#include <counting_sort.hpp>
+#include <parallel_counting_sort.hpp>
+
+namespace proud_color_sorter::tests {
+
+namespace {
+
+constexpr ColorOrder kOrder = samples::MakeOrder(Color::kGreen, Color::kRed, Color::kBlue);
+
+}  // namespace
+
+TEST(ParallelCountingSortTest, empty_array) {
+  std::vector<Color> colors;
+
+  auto sorted_colors = ParallelCountingSort(colors, kOrder, {/*thread_count=*/4, /*serial_threshold=*/0});
+
+  EXPECT_TRUE(sorted_colors.empty());
+}
+
+TEST(ParallelCountingSortTest, matches_counting_sort) {
+  const std::vector<std::size_t> sizes{1, 3, 7, 1000, 100'003};
+  const std::vector<std::size_t> thread_counts{1, 2, 3, 8};
+
+  for (const std::size_t size : sizes) {
+    auto colors = samples::GenerateColors(size);
+
+    for (const std::size_t thread_count : thread_counts) {
+      auto sorted_colors = ParallelCountingSort(colors, kOrder, {thread_count, /*serial_threshold=*/0});
+      EXPECT_EQ(sorted_colors, CountingSort(colors, kOrder)) << "size: " << size << ", threads: " << thread_count;
+    }
+  }
+}
+
+TEST(ParallelCountingSortTest, in_place) {
+  auto colors = samples::GenerateColors(10'000);
+  const auto expected = CountingSort(colors, kOrder);
+
+  ParallelCountingSort(colors.data(), colors.data() + colors.size(), kOrder, colors.data(),
+                       {/*thread_count=*/4, /*serial_threshold=*/0});
+
+  EXPECT_EQ(colors, expected);
+}
+
+TEST(ParallelCountingSortTest, serial_fallback_below_threshold) {
+  auto colors = samples::GenerateColors(100);
+
+  auto sorted_colors = ParallelCountingSort(colors, kOrder, {/*thread_count=*/4, /*serial_threshold=*/1000});
+
+  EXPECT_EQ(sorted_colors, CountingSort(colors, kOrder));
+}
+
+TEST(ParallelCountingSortTest, checked_colors) {
+  auto colors = samples::GenerateColors(10'000);
+  const auto expected = CountingSort(colors, kOrder);
+  ParallelSortOptions options{/*thread_count=*/4, /*serial_threshold=*/0, /*check_colors=*/true};
+
+  EXPECT_EQ(ParallelCountingSort(colors, kOrder, options), expected);
+
+  colors[9'999] = static_cast<Color>(kColorSize);
+  std::vector<Color> out(colors.size(), Color::kRed);
+
+  for (const std::size_t serial_threshold : {std::size_t{0}, colors.size() + 1}) {
+    options.serial_threshold = serial_threshold;
+    EXPECT_THROW(ParallelCountingSort(colors.data(), colors.data() + colors.size(), kOrder, out.data(), options),
+                 std::runtime_error);
+    EXPECT_EQ(out, std::vector<Color>(colors.size(), Color::kRed));
+  }
+}
+
+}  // namespace proud_color_sorter::tests
@@ -0,0 +1,103 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color.hpp>
+#include <utils/random_generator.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(Xoshiro256StarStarTests, same_seed_gives_same_sequence) {
+  utils::Xoshiro256StarStar lhs{42};
+  utils::Xoshiro256StarStar rhs{42};
+  utils::Xoshiro256StarStar other{43};
+  bool differs_from_other = false;
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    const auto value = lhs();
+    ASSERT_EQ(value, rhs());
+    differs_from_other = differs_from_other || value != other();
+  }
+
+  ASSERT_TRUE(differs_from_other);
+}
+
+TEST(ColorGeneratorTests, generates_only_valid_colors) {
+  utils::ColorGenerator generator{1};
+  std::vector<Color> colors(10'000);
+  generator.Generate(colors.data(), colors.data() + colors.size());
+
+  for (const Color color : colors) {
+    ASSERT_LT(static_cast<std::size_t>(color), kColorSize);
+  }
+}
+
+TEST(ColorGeneratorTests, same_seed_gives_same_colors) {
+  utils::ColorGenerator lhs_generator{7};
+  utils::ColorGenerator rhs_generator{7};
+  std::vector<Color> lhs(1000);
+  std::vector<Color> rhs(1000);
+
+  lhs_generator.Generate(lhs.data(), lhs.data() + lhs.size());
+  rhs_generator.Generate(rhs.data(), rhs.data() + rhs.size());
+
+  ASSERT_EQ(lhs, rhs);
+}
+
+TEST(ColorGeneratorTests, does_not_write_out_of_range) {
+  constexpr std::size_t kGuardSize = 8;
+  constexpr auto kGuard = static_cast<Color>(0xFF);
+  utils::ColorGenerator generator{3};
+
+  for (std::size_t size = 0; size <= 3 * utils::ColorGenerator::kColorsPerDraw; ++size) {
+    std::vector<Color> colors(size + kGuardSize, kGuard);
+    generator.Generate(colors.data(), colors.data() + size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+      ASSERT_NE(colors[i], kGuard);
+    }
+
+    for (std::size_t i = size; i < colors.size(); ++i) {
+      ASSERT_EQ(colors[i], kGuard);
+    }
+  }
+}
+
+TEST(ColorGeneratorTests, colors_are_uniformly_distributed) {
+  constexpr std::size_t kSize = 3'000'000;
+  utils::ColorGenerator generator{11};
+  std::vector<Color> colors(kSize);
+  generator.Generate(colors.data(), colors.data() + colors.size());
+
+  // Counts of every color and of every pair of adjacent colors, so digits of a single draw are checked to be
+  // independent too.
+  std::array<std::size_t, kColorSize> counts{};
+  std::array<std::size_t, kColorSize * kColorSize> pair_counts{};
+
+  for (std::size_t i = 0; i < kSize; ++i) {
+    ++counts[static_cast<std::size_t>(colors[i])];
+
+    if (i % 2 == 1) {
+      ++pair_counts[static_cast<std::size_t>(colors[i - 1]) * kColorSize + static_cast<std::size_t>(colors[i])];
+    }
+  }
+
+  const auto chi_square = [](const auto& observed, const double expected) {
+    double statistic = 0;
+
+    for (const std::size_t count : observed) {
+      const double difference = static_cast<double>(count) - expected;
+      statistic += difference * difference / expected;
+    }
+
+    return statistic;
+  };
+
+  // 99.9% quantiles of chi-square distribution with 2 and 8 degrees of freedom.
+  ASSERT_LT(chi_square(counts, kSize / static_cast<double>(kColorSize)), 13.82);
+  ASSERT_LT(chi_square(pair_counts, kSize / 2 / static_cast<double>(kColorSize * kColorSize)), 26.12);
+}
+
+}  // namespace proud_color_sorter::tests
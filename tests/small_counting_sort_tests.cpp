@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <counting_sort.hpp>
+#include <enum_traits.hpp>
+#include <order.hpp>
+#include <small_counting_sort.hpp>
+#include <utils/random_generator.hpp>
+
+namespace proud_color_sorter {
+
+/// Category of a 256-value domain.
+enum class Category : std::uint8_t {};
+
+template <>
+struct DenseEnumTraits<Category> {
+  static constexpr std::size_t kSize = 256;
+};
+
+namespace tests {
+
+namespace {
+
+template <typename Key, std::size_t DomainSize>
+std::vector<Key> GenerateKeys(const std::size_t size) {
+  utils::Xoshiro256StarStar engine{size};
+  std::vector<Key> keys(size);
+
+  for (Key& key : keys) {
+    key = static_cast<Key>(engine() % DomainSize);
+  }
+
+  return keys;
+}
+
+/// Ranks keys in the reversed order of their values.
+template <typename Key, std::size_t DomainSize>
+Order<Key, DomainSize> MakeReversedOrder() {
+  Order<Key, DomainSize> order;
+
+  for (std::size_t i = 0; i < DomainSize; ++i) {
+    order.Set(static_cast<Key>(i), DomainSize - 1 - i);
+  }
+
+  return order;
+}
+
+template <std::size_t DomainSize, typename Key, typename OrderType>
+void ExpectSortedLikeStdSort(const std::vector<Key>& keys, const OrderType& order) {
+  std::vector<Key> expected = keys;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&order](const Key lhs, const Key rhs) { return order.IsLess(lhs, rhs); });
+
+  std::vector<Key> sorted(keys.size());
+  SmallCountingSort<DomainSize>(keys.data(), keys.data() + keys.size(), order, sorted.data());
+
+  EXPECT_EQ(sorted, expected);
+}
+
+}  // namespace
+
+TEST(SmallCountingSortTests, count_keys_in_registers) {
+  const std::vector<Color> colors{Color::kRed, Color::kBlue, Color::kBlue, Color::kGreen, Color::kBlue};
+
+  const auto histogram = CountKeys<kColorSize>(colors.data(), colors.data() + colors.size());
+
+  ASSERT_EQ(histogram, (KeyHistogram<kColorSize>{1, 1, 3}));
+}
+
+TEST(SmallCountingSortTests, count_keys_interleaved) {
+  const auto keys = GenerateKeys<std::uint8_t, 256>(10007);
+  KeyHistogram<256> expected{};
+
+  for (const std::uint8_t key : keys) {
+    ++expected[key];
+  }
+
+  ASSERT_EQ(CountKeys<256>(keys.data(), keys.data() + keys.size()), expected);
+}
+
+TEST(SmallCountingSortTests, empty_range) {
+  const ColorOrder order = MakeReversedOrder<Color, kColorSize>();
+  const Color* none = nullptr;
+
+  ASSERT_EQ(CountKeys<kColorSize>(none, none), (KeyHistogram<kColorSize>{}));
+  ASSERT_EQ(CountKeys<256>(none, none), (KeyHistogram<256>{}));
+  SmallCountingSort<kColorSize>(none, none, order, static_cast<Color*>(nullptr));
+}
+
+TEST(SmallCountingSortTests, colors_match_counting_sort) {
+  ColorOrder order;
+  order.Set(Color::kBlue, 0);
+  order.Set(Color::kRed, 1);
+  order.Set(Color::kGreen, 2);
+
+  for (const std::size_t size : std::vector<std::size_t>{1, 3, 17, 1000, 65537}) {
+    const auto colors = GenerateKeys<Color, kColorSize>(size);
+    std::vector<Color> sorted(colors.size());
+
+    SmallCountingSort<kColorSize>(colors.data(), colors.data() + colors.size(), order, sorted.data());
+
+    ASSERT_EQ(sorted, CountingSort(colors, order)) << "size=" << size;
+  }
+}
+
+TEST(SmallCountingSortTests, sort_in_place) {
+  const auto order = MakeReversedOrder<Color, kColorSize>();
+  auto colors = GenerateKeys<Color, kColorSize>(100);
+  const auto expected = CountingSort(colors, order);
+
+  SmallCountingSort<kColorSize>(colors.data(), colors.data() + colors.size(), order, colors.data());
+
+  ASSERT_EQ(colors, expected);
+}
+
+TEST(SmallCountingSortTests, sixteen_value_domain) {
+  ExpectSortedLikeStdSort<16>(GenerateKeys<std::uint8_t, 16>(5003), MakeReversedOrder<std::uint8_t, 16>());
+}
+
+TEST(SmallCountingSortTests, byte_domain) {
+  ExpectSortedLikeStdSort<256>(GenerateKeys<std::uint8_t, 256>(100003), MakeReversedOrder<std::uint8_t, 256>());
+}
+
+TEST(SmallCountingSortTests, dense_enum_domain) {
+  ExpectSortedLikeStdSort<256>(GenerateKeys<Category, 256>(100003), MakeReversedOrder<Category, 256>());
+}
+
+TEST(SmallCountingSortTests, wide_keys) {
+  ExpectSortedLikeStdSort<200>(GenerateKeys<std::uint32_t, 200>(20011), MakeReversedOrder<std::uint32_t, 200>());
+}
+
+}  // namespace tests
+
+}  // namespace proud_color_sorter
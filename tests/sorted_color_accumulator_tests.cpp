@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_samples.hpp>
+#include <counting_sort.hpp>
+#include <sorted_color_accumulator.hpp>
+#include <sorted_runs.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(SortedColorAccumulatorTests, empty) {
+  const SortedColorAccumulator accumulator{samples::MakeOrder()};
+
+  EXPECT_TRUE(accumulator.IsEmpty());
+  EXPECT_EQ(accumulator.Size(), 0);
+  EXPECT_EQ(accumulator.Rank(Color::kGreen), 0);
+  EXPECT_TRUE(accumulator.Snapshot().Materialize().empty());
+}
+
+TEST(SortedColorAccumulatorTests, insert_and_remove) {
+  SortedColorAccumulator accumulator{samples::MakeOrder()};
+  accumulator.Insert(Color::kRed);
+  accumulator.Insert(Color::kGreen, 2);
+  accumulator.Insert(Color::kBlue);
+
+  EXPECT_EQ(accumulator.Size(), 4);
+  EXPECT_EQ(accumulator.Count(Color::kGreen), 2);
+
+  EXPECT_TRUE(accumulator.Remove(Color::kGreen));
+  EXPECT_FALSE(accumulator.Remove(Color::kRed, 2));
+  EXPECT_TRUE(accumulator.Remove(Color::kBlue));
+  EXPECT_FALSE(accumulator.Remove(Color::kBlue));
+
+  EXPECT_EQ(accumulator.Size(), 2);
+  EXPECT_EQ(accumulator.Snapshot().Materialize(), (std::vector<Color>{Color::kRed, Color::kGreen}));
+
+  accumulator.Clear();
+
+  EXPECT_TRUE(accumulator.IsEmpty());
+  EXPECT_EQ(accumulator.Count(Color::kRed), 0);
+}
+
+TEST(SortedColorAccumulatorTests, snapshot_matches_counting_sort) {
+  const auto colors = samples::GenerateColors(1000);
+  SortedColorAccumulator accumulator{samples::MakeOrder()};
+
+  for (std::size_t i = 0; i < colors.size(); ++i) {
+    accumulator.Insert(colors[i]);
+
+    if (i % 97 == 0) {
+      const std::vector<Color> prefix(colors.begin(), colors.begin() + static_cast<std::ptrdiff_t>(i + 1));
+      ASSERT_EQ(accumulator.Snapshot().Materialize(), CountingSort(prefix, samples::MakeOrder())) << "i=" << i;
+    }
+  }
+
+  SortedColorAccumulator bulk{samples::MakeOrder()};
+  bulk.Insert(colors.data(), colors.data() + colors.size());
+
+  EXPECT_EQ(bulk.GetHistogram(), accumulator.GetHistogram());
+}
+
+TEST(SortedColorAccumulatorTests, rank_and_select) {
+  const auto colors = samples::GenerateColors(500);
+  SortedColorAccumulator accumulator{samples::MakeOrder()};
+  accumulator.Insert(colors.data(), colors.data() + colors.size());
+  const auto sorted = CountingSort(colors, samples::MakeOrder());
+
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    ASSERT_EQ(accumulator.Select(i), sorted[i]) << "i=" << i;
+  }
+
+  const auto order = samples::MakeOrder();
+
+  for (const Color color : order) {
+    const auto expected = std::count_if(sorted.begin(), sorted.end(),
+                                        [&order, color](const Color other) { return order.IsLess(other, color); });
+
+    EXPECT_EQ(accumulator.Rank(color), static_cast<std::size_t>(expected));
+  }
+}
+
+TEST(SortedColorAccumulatorTests, merge) {
+  const auto lhs_colors = samples::GenerateColors(300);
+  const auto rhs_colors = samples::GenerateColors(700);
+
+  SortedColorAccumulator lhs{samples::MakeOrder()};
+  lhs.Insert(lhs_colors.data(), lhs_colors.data() + lhs_colors.size());
+  SortedColorAccumulator rhs{samples::MakeOrder(Color::kGreen, Color::kRed, Color::kBlue)};
+  rhs.Insert(rhs_colors.data(), rhs_colors.data() + rhs_colors.size());
+
+  lhs.Merge(rhs);
+
+  std::vector<Color> all_colors;
+  all_colors.reserve(lhs_colors.size() + rhs_colors.size());
+  all_colors.insert(all_colors.end(), lhs_colors.begin(), lhs_colors.end());
+  all_colors.insert(all_colors.end(), rhs_colors.begin(), rhs_colors.end());
+
+  EXPECT_EQ(lhs.Size(), all_colors.size());
+  EXPECT_EQ(lhs.Snapshot().Materialize(), CountingSort(all_colors, samples::MakeOrder()));
+}
+
+}  // namespace proud_color_sorter::tests
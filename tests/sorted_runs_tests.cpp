@@ -0,0 +1,68 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color_samples.hpp>
+#include <counting_sort.hpp>
+#include <sorted_runs.hpp>
+
+namespace proud_color_sorter::tests {
+
+TEST(SortedRunsTests, empty_sequence) {
+  std::vector<Color> colors;
+
+  auto runs = CountingSortRuns(colors, samples::MakeOrder());
+
+  EXPECT_EQ(runs.Size(), 0);
+  EXPECT_EQ(runs.begin(), runs.end());
+  EXPECT_TRUE(runs.Materialize().empty());
+}
+
+TEST(SortedRunsTests, runs_boundaries) {
+  std::vector<Color> colors{Color::kRed, Color::kGreen, Color::kBlue, Color::kRed, Color::kRed, Color::kBlue};
+
+  auto runs = CountingSortRuns(colors, samples::MakeOrder());
+
+  ASSERT_EQ(runs.Size(), colors.size());
+
+  const auto& blue = runs.GetRun(Color::kBlue);
+  EXPECT_EQ(blue.color, Color::kBlue);
+  EXPECT_EQ(blue.offset, 0);
+  EXPECT_EQ(blue.count, 2);
+
+  const auto& red = runs.GetRun(Color::kRed);
+  EXPECT_EQ(red.offset, 2);
+  EXPECT_EQ(red.count, 3);
+
+  const auto& green = runs.GetRuns()[2];
+  EXPECT_EQ(green.color, Color::kGreen);
+  EXPECT_EQ(green.offset, 5);
+  EXPECT_EQ(green.count, 1);
+}
+
+TEST(SortedRunsTests, lazy_view_matches_counting_sort) {
+  std::vector<Color> colors{Color::kGreen, Color::kGreen, Color::kRed, Color::kGreen, Color::kRed};
+  const auto order = samples::MakeOrder();
+
+  auto runs = CountingSortRuns(colors, order);
+  auto expected = CountingSort(colors, order);
+
+  EXPECT_EQ(std::vector<Color>(runs.begin(), runs.end()), expected);
+  EXPECT_EQ(runs.Materialize(), expected);
+
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(runs.Get(i), expected[i]);
+  }
+}
+
+TEST(SortedRunsTests, all_orders) {
+  std::vector<Color> colors{Color::kRed, Color::kGreen, Color::kBlue, Color::kRed, Color::kRed, Color::kBlue};
+
+  const auto all_runs = CountingSortRunsAllOrders(colors.data(), colors.data() + colors.size());
+
+  for (std::size_t i = 0; i < kColorOrderCount; ++i) {
+    EXPECT_EQ(all_runs[i].Materialize(), CountingSort(colors, kAllColorOrders[i])) << "order #" << i;
+  }
+}
+
+}  // namespace proud_color_sorter::tests